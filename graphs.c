@@ -1,9 +1,81 @@
+// Build: gcc graphs.c -o graphs -pthread
 #include <stdio.h>
 #include <stdlib.h>
+#include <string.h>
 #include <limits.h>
+#include <time.h>
+#include <pthread.h>
+#include <unistd.h>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
 
-// Define maximum number of vertices
-#define MAX 100
+// Initial capacity of a Queue (must be a power of two)
+#define QUEUE_INITIAL_CAPACITY 16
+
+// Adjacency list node slabs: the first slab of a graph holds NODE_SLAB_MIN_NODES
+// nodes and each further one doubles, up to NODE_SLAB_MAX_NODES
+#define NODE_SLAB_MIN_NODES 256
+#define NODE_SLAB_MAX_NODES (1 << 20)
+
+// Radix sort parameters for Kruskal's edge sort
+#define RADIX_BITS 8
+#define RADIX_BUCKETS (1 << RADIX_BITS)
+#define PARALLEL_SORT_THRESHOLD (1 << 16)
+
+// Direction-optimizing BFS switch thresholds (Beamer et al.)
+#define DOBFS_ALPHA 14
+#define DOBFS_BETA 24
+
+// Frontier vertices a parallel BFS thread claims at a time
+#define PARALLEL_BFS_CHUNK 64
+
+// Edges (or vertices) a parallel connected components thread claims at a time
+#define PARALLEL_CC_CHUNK 4096
+
+// How many edges ahead dsuUnionBatch prefetches parent slots
+#define DSU_PREFETCH_DISTANCE 8
+
+// Default arity of the d-ary heap used by Dijkstra
+#define DARY_HEAP_DEFAULT_ARITY 4
+
+// Number of buckets in a radix heap over 32-bit keys
+#define RADIX_HEAP_BUCKETS 33
+
+// Largest graph for which main keeps a dense adjacency matrix (V * V ints)
+#define MATRIX_MAX_VERTICES 1000
+
+// Landmarks used by the A* (ALT) heuristic
+#define ALT_DEFAULT_LANDMARKS 8
+
+// Contraction hierarchy preprocessing: witness search budgets (settled vertices)
+// when contracting and when estimating priorities, and edge-difference weight
+#define CH_WITNESS_SETTLE_LIMIT 128
+#define CH_SIMULATE_SETTLE_LIMIT 16
+#define CH_PRIORITY_EDGE_WEIGHT 4
+
+// Contraction hierarchy file header
+#define CH_FILE_MAGIC 0x31484347 // "GCH1"
+#define CH_FILE_VERSION 1
+
+// Binary edge-list file header
+#define EDGE_FILE_MAGIC 0x314C4547 // "GEL1"
+#define EDGE_FILE_VERSION 1
+
+// Graph snapshot file header; CSR sections start on cache lines and the edge
+// section on a boundary that is a multiple of any page size, so it can be
+// remapped writable on its own
+#define SNAPSHOT_FILE_MAGIC 0x314E5347 // "GSN1"
+#define SNAPSHOT_FILE_VERSION 1
+#define SNAPSHOT_SECTION_ALIGN 64
+#define SNAPSHOT_EDGES_ALIGN 65536
+
+// Dynamic graph: smallest arc block of a vertex, batch size below which updates
+// are applied on one thread, and log2 of the run of consecutive vertices owned
+// by the same update thread (keeps threads off each other's cache lines)
+#define DYNAMIC_MIN_BLOCK 4
+#define DYNAMIC_PARALLEL_MIN_BATCH 4096
+#define DYNAMIC_OWNER_SHIFT 6
 
 // Structure for adjacency list node
 typedef struct AdjListNode
@@ -19,14 +91,35 @@ typedef struct AdjList
     AdjListNode *head;
 } AdjList;
 
+// Block of adjacency list nodes carved out by bumping used
+typedef struct NodeSlab
+{
+    struct NodeSlab *next; // Previously filled slab
+    size_t used;
+    size_t capacity;
+    AdjListNode nodes[];
+} NodeSlab;
+
 // Structure for graph
 typedef struct Graph
 {
     int V;
     AdjList *array;
-    int **adjMatrix;
+    int **adjMatrix; // NULL when the graph was created without a matrix
+    NodeSlab *slabs; // Arena owning every node of the lists, newest slab first
 } Graph;
 
+// Structure for graph in Compressed Sparse Row (CSR) form
+// Arcs of vertex u are dest[offsets[u]] .. dest[offsets[u + 1] - 1]
+typedef struct CSRGraph
+{
+    int V;
+    int E; // Number of stored arcs (an undirected edge is stored twice)
+    int *offsets;
+    int *dest;
+    int *weight;
+} CSRGraph;
+
 // Structure for edge used in Kruskal's algorithm
 typedef struct Edge
 {
@@ -51,17 +144,227 @@ typedef struct MinHeap
     MinHeapNode **array;
 } MinHeap;
 
+// Explicit stack frame for iterative DFS on adjacency lists
+typedef struct DFSFrame
+{
+    int v;
+    AdjListNode *next; // Next arc of v to examine
+} DFSFrame;
+
+// Explicit stack frame for iterative DFS on CSR graphs
+typedef struct DFSFrameCSR
+{
+    int v;
+    int next; // Index of the next arc of v to examine
+} DFSFrameCSR;
+
+// Structure for entry of a flat d-ary heap (plain value, no per-node allocation)
+typedef struct HeapEntry
+{
+    int dist;
+    int v;
+} HeapEntry;
+
+// Structure for d-ary min-heap of HeapEntry, children of i are d*i+1 .. d*i+d
+typedef struct DaryHeap
+{
+    HeapEntry *items;
+    int size;
+    int capacity;
+    int d;
+} DaryHeap;
+
+// Structure for radix heap: monotone integer priority queue
+// Bucket 0 holds keys equal to last; bucket b holds keys whose highest bit
+// differing from last is bit b - 1
+typedef struct RadixHeap
+{
+    HeapEntry *bucket[RADIX_HEAP_BUCKETS];
+    int count[RADIX_HEAP_BUCKETS];
+    int capacity[RADIX_HEAP_BUCKETS];
+    unsigned int last; // Last key popped
+    int size;
+} RadixHeap;
+
+// Priority queue used by dijkstraShortestPathsQueue
+typedef enum
+{
+    DIJKSTRA_INDEXED_HEAP,
+    DIJKSTRA_DARY_HEAP,
+    DIJKSTRA_RADIX_HEAP,
+    DIJKSTRA_DIAL
+} DijkstraQueue;
+
 // Structure for DSU (Disjoint Set Union)
+// parent[x] is the parent of x, or minus the size of x's set if x is a root
 typedef struct DSU
 {
     int *parent;
-    int *rank;
     int size;
 } DSU;
 
+// V x V distance matrix in a memory mapping (file-backed or anonymous)
+typedef struct DistanceMatrix
+{
+    int V;
+    int *dist; // dist[u * V + v]
+    size_t bytes;
+} DistanceMatrix;
+
+// Edge list read from a file by loadEdgeList
+typedef struct EdgeList
+{
+    int V;
+    int E;
+    int directed;
+    Edge *edges;
+    void *map; // Mapping of a binary file that edges points into, NULL if edges is malloc'd
+    size_t mapBytes;
+} EdgeList;
+
+// Header of a binary edge-list file; E Edge records follow in native byte order
+typedef struct EdgeFileHeader
+{
+    int magic;
+    int version;
+    int V;
+    int E;
+    int directed;
+    int reserved; // Written as 0
+} EdgeFileHeader;
+
+// Header of a graph snapshot file, followed by the CSR offsets, dest and weight
+// arrays and the Edge array (positions given by snapshotLayout)
+typedef struct SnapshotFileHeader
+{
+    int magic;
+    int version;
+    int V;
+    int arcs; // CSR arcs (an undirected edge is stored twice)
+    int E;    // Edge records
+    int directed;
+    long long bytes; // File size
+} SnapshotFileHeader;
+
+// Graph opened by openGraphSnapshot: csr and edges point into a private mapping
+// of the file. The CSR arrays are read-only; the edge pages are copy-on-write so
+// in-place sorts (Kruskal's) work without changing the file. Never freeCSR(&csr).
+typedef struct GraphSnapshot
+{
+    CSRGraph csr;
+    Edge *edges;
+    int E;
+    int directed;
+    void *map;
+    size_t mapBytes;
+} GraphSnapshot;
+
+// Out-arc of a dynamic graph vertex
+typedef struct DynamicArc
+{
+    int dest;
+    int weight;
+} DynamicArc;
+
+// Per-vertex arc blocks: arcs[v] holds degree[v] arcs in a block of capacity[v]
+typedef struct DynamicAdjacency
+{
+    DynamicArc **arcs;
+    int *degree;
+    int *capacity;
+} DynamicAdjacency;
+
+// Weight change of one arc src -> dest (and its reverse if undirected)
+// oldWeight picks the arc among parallel ones, as in dynamicGraphDeleteEdges
+typedef struct WeightChange
+{
+    int src;
+    int dest;
+    int oldWeight;
+    int newWeight;
+} WeightChange;
+
+// Mutable graph: every vertex keeps its arcs in its own growable block, so an arc
+// insertion or deletion touches a single block per direction. A directed graph
+// also mirrors each arc u -> v into in-block v (dest = u) for searches that need
+// predecessors; for an undirected graph in and out are the same blocks. Updates
+// come in batches that hold the write lock; traversals hold the read lock, so
+// they always see the graph as it was between two batches.
+typedef struct DynamicGraph
+{
+    int V;
+    int directed;
+    DynamicAdjacency out;
+    DynamicAdjacency in;
+    long long arcCount;
+    long long version; // Number of batches applied
+    pthread_rwlock_t lock;
+} DynamicGraph;
+
+// Callback for A*: lower bound on the distance from v to target
+typedef int (*AStarHeuristic)(int v, int target, void *context);
+
+// Reusable state for point-to-point queries; index 0 is the forward search,
+// index 1 the backward search. A label is valid only if seen[side][v] == stamp.
+typedef struct QueryWorkspace
+{
+    int V;
+    int stamp;
+    int *dist[2];
+    int *parent[2];
+    int *seen[2];
+    int *settled[2];
+    DaryHeap *heap[2];
+} QueryWorkspace;
+
+// Landmark distances for the ALT heuristic
+typedef struct Landmarks
+{
+    int count;
+    int *vertex;
+    int **from; // from[i][v] = distance from landmark i to v
+    int **to;   // to[i][v] = distance from v to landmark i
+} Landmarks;
+
+// Contraction hierarchy: rank is the contraction order; up holds arcs u -> v with
+// rank[v] > rank[u], down holds for each v the arcs u -> v with rank[u] > rank[v]
+// (stored reversed, so both searches of a query only climb)
+typedef struct ContractionHierarchy
+{
+    int V;
+    int *rank;
+    CSRGraph *up;
+    CSRGraph *down;
+    long long shortcuts; // Shortcut arcs added during preprocessing
+} ContractionHierarchy;
+
+// Growable arc list of the overlay graph used while contracting
+typedef struct CHArcList
+{
+    int *to;
+    int *weight;
+    int count;
+    int capacity;
+} CHArcList;
+
+// Preprocessing state: overlay graph of the vertices not yet contracted
+typedef struct CHBuild
+{
+    CHArcList *out;
+    CHArcList *in;
+    int *contractedNeighbours;
+    int *level; // Longest chain of contracted vertices below each vertex
+    int *key;   // Current priority; heap entries with another key are stale
+    int *mark;  // mark[x] == markStamp flags x (witness target or updated neighbour)
+    int markStamp;
+    QueryWorkspace *ws; // Witness searches use side 0
+} CHBuild;
+
 // Function prototypes
 Graph *createGraph(int V);
-AdjListNode *newAdjListNode(int dest, int weight);
+Graph *createGraphWithMatrix(int V, int withMatrix);
+void freeGraph(Graph *graph);
+AdjListNode *newAdjListNode(Graph *graph, int dest, int weight);
 void addEdgeList(Graph *graph, int src, int dest, int weight, int directed);
 void addEdgeMatrix(Graph *graph, int src, int dest, int weight, int directed);
 void printAdjList(Graph *graph);
@@ -71,52 +374,210 @@ void DFS_ListUtil(Graph *graph, int v, int *visited);
 void DFS_List(Graph *graph, int start);
 Graph *reverseGraph(Graph *graph);
 Graph *convertUndirectedToDirected(Graph *graph);
-void topologicalSortDFSUtil(Graph *graph, int v, int *visited, int *stack, int *top);
+void topologicalSortDFSUtil(Graph *graph, int v, int *visited, int *stack, int *top, DFSFrame *frames);
+int topologicalOrderDFS(Graph *graph, int *order);
 void topologicalSortDFS(Graph *graph);
+int topologicalOrderBFS(Graph *graph, int *order);
 void topologicalSortBFS(Graph *graph);
+int sccTarjan(Graph *graph, int *comp);
+int sccKosaraju(Graph *graph, int *comp);
+Graph *condenseGraph(Graph *graph, int *comp, int count);
+void stronglyConnectedComponents(Graph *graph);
+void bfsShortestPaths(Graph *graph, int start, int *dist, int *parent);
 void shortestPathBFS(Graph *graph, int start);
+void dijkstraShortestPaths(Graph *graph, int src, int *dist, int *parent);
 void shortestPathDijkstra(Graph *graph, int start);
+int bellmanFordShortestPaths(int V, Edge edges[], int E, int src, int *dist, int *parent);
 void shortestPathBellmanFord(Graph *graph, int V, Edge edges[], int E, int start);
+int spfaShortestPathsCSR(CSRGraph *csr, int src, int *dist, int *parent);
+int spfaShortestPaths(int V, Edge edges[], int E, int src, int *dist, int *parent);
+void shortestPathSPFA(int V, Edge edges[], int E, int src);
+int bellmanFordShortestPathsParallel(int V, Edge edges[], int E, int src, int *dist, int *parent, int numThreads);
+void shortestPathBellmanFordParallel(int V, Edge edges[], int E, int src);
+int primMSTEdges(Graph *graph, Edge result[]);
 void primMST(Graph *graph);
+void printDistances(int *dist, int V);
+long long mstTotalWeight(Edge result[], int e);
+void printMSTEdges(const char *title, Edge result[], int e);
+void printVertexOrder(const char *label, int *order, int count);
 void kruskalMST(Graph *graph, Edge edges[], int E);
+int kruskalMSTEdges(int V, Edge edges[], int E, Edge result[]);
+void boruvkaMST(Graph *graph, Edge edges[], int E);
+int boruvkaMSTEdges(int V, Edge edges[], int E, Edge result[], int numThreads);
+void freeDSU(DSU *dsu);
+int dsuSetSize(DSU *dsu, int x);
+int dsuUnionBatch(DSU *dsu, Edge edges[], int E, Edge *merged);
+int dsuFindConcurrent(DSU *dsu, int x);
+int dsuUnionConcurrent(DSU *dsu, int x, int y);
+int connectedComponentsParallel(int V, Edge edges[], int E, int *label, int numThreads);
+void connectedComponents(int V, Edge edges[], int E);
+int getThreadCount(void);
+void runThreads(void *(*worker)(void *), void *tasks, size_t taskSize, int numThreads);
+double wallClockSeconds(void);
+void bubbleSortEdges(Edge edges[], int E);
+void radixSortEdges(Edge edges[], int E, int numThreads);
+Edge *generateRandomEdges(int V, int E, int maxWeight, unsigned int seed);
+void benchmarkKruskalSort(int E, int maxWeight);
+void benchmarkMST(int V, int E, int maxWeight);
+void benchmarkParallelBFS(int V, int E);
+void benchmarkDijkstraHeaps(int V, int E, int maxWeight);
+void benchmarkDeltaStepping(int V, int E, int maxWeight, int delta);
+void benchmarkPointToPoint(int V, int E, int maxWeight, int queries);
+void benchmarkContractionHierarchy(int side, int maxWeight, int queries);
+void benchmarkBellmanFord(int V, int E, int maxWeight);
+void benchmarkMultiSource(int V, int E, int maxWeight, int sources);
+void benchmarkSCC(int V, int E);
+void benchmarkConnectedComponents(int V, int E);
+void benchmarkDSU(int n, int E);
+void benchmarkEdgeListLoad(int V, int E);
+void benchmarkGraphSnapshot(int V, int E);
+void benchmarkGraphBuild(int V, int E);
+void benchmarkDynamicGraph(int V, int E, int batchSize);
+void benchmarkIncrementalSSSP(int V, int E, int changes);
 int findSet(int parent[], int i);
 void unionSet(int parent[], int rank[], int x, int y);
 MinHeapNode *newMinHeapNode(int v, int dist);
 MinHeap *createMinHeap(int capacity);
+void freeMinHeap(MinHeap *minHeap);
 void swapMinHeapNode(MinHeapNode **a, MinHeapNode **b);
 void minHeapify(MinHeap *minHeap, int idx);
 int isEmpty(MinHeap *minHeap);
 MinHeapNode *extractMin(MinHeap *minHeap);
 void decreaseKey(MinHeap *minHeap, int v, int dist);
+DaryHeap *createDaryHeap(int capacity, int d);
+void freeDaryHeap(DaryHeap *heap);
+int isEmptyDaryHeap(DaryHeap *heap);
+void daryHeapPush(DaryHeap *heap, int dist, int v);
+HeapEntry daryHeapPop(DaryHeap *heap);
+RadixHeap *createRadixHeap(void);
+void freeRadixHeap(RadixHeap *heap);
+void radixHeapPush(RadixHeap *heap, int dist, int v);
+HeapEntry radixHeapPop(RadixHeap *heap);
+CSRGraph *createCSRFromGraph(Graph *graph);
+CSRGraph *createCSRFromEdges(int V, Edge edges[], int E, int directed);
+void freeCSR(CSRGraph *csr);
+void printCSR(CSRGraph *csr);
+void BFS_CSR(CSRGraph *csr, int start);
+void DFS_CSRUtil(CSRGraph *csr, int v, int *visited);
+void DFS_CSR(CSRGraph *csr, int start);
+void topologicalSortDFS_CSRUtil(CSRGraph *csr, int v, int *visited, int *stack, int *top, DFSFrameCSR *frames);
+int topologicalOrderDFS_CSR(CSRGraph *csr, int *order);
+void topologicalSortDFS_CSR(CSRGraph *csr);
+int topologicalOrderBFS_CSR(CSRGraph *csr, int *order);
+void topologicalSortBFS_CSR(CSRGraph *csr);
+void bfsShortestPathsCSR(CSRGraph *csr, int start, int *dist, int *parent);
+void shortestPathBFS_CSR(CSRGraph *csr, int start);
+void dijkstraShortestPathsCSR(CSRGraph *csr, int src, int *dist, int *parent);
+void shortestPathDijkstraCSR(CSRGraph *csr, int src);
+int primMSTEdgesCSR(CSRGraph *csr, Edge result[]);
+void primMST_CSR(CSRGraph *csr);
+void dijkstraShortestPathsDary(CSRGraph *csr, int src, int *dist, int *parent, int d, DaryHeap *heap);
+void shortestPathDijkstraDary(CSRGraph *csr, int src, int d);
+void dijkstraShortestPathsRadix(CSRGraph *csr, int src, int *dist, int *parent);
+void dijkstraShortestPathsDial(CSRGraph *csr, int src, int *dist, int *parent);
+int dijkstraShortestPathsQueue(CSRGraph *csr, int src, int *dist, int *parent, DijkstraQueue queue);
+void shortestPathDijkstraQueue(CSRGraph *csr, int src, DijkstraQueue queue);
+int deltaSteppingShortestPaths(CSRGraph *csr, int src, int *dist, int delta, int numThreads);
+void shortestPathDeltaStepping(CSRGraph *csr, int src, int delta);
+QueryWorkspace *createQueryWorkspace(int V);
+void freeQueryWorkspace(QueryWorkspace *ws);
+int bidirectionalDijkstra(CSRGraph *csr, CSRGraph *rev, int s, int t, QueryWorkspace *ws,
+                          int *path, int *pathLen, int *settledCount);
+int aStarShortestPath(CSRGraph *csr, int s, int t, AStarHeuristic heuristic, void *context,
+                      QueryWorkspace *ws, int *path, int *pathLen, int *settledCount);
+int zeroHeuristic(int v, int target, void *context);
+Landmarks *createLandmarks(CSRGraph *csr, CSRGraph *rev, int count);
+void freeLandmarks(Landmarks *lm);
+int landmarkHeuristic(int v, int target, void *context);
+void shortestPathBidirectional(CSRGraph *csr, CSRGraph *rev, int s, int t);
+void shortestPathAStar(CSRGraph *csr, Landmarks *lm, int s, int t);
+ContractionHierarchy *buildContractionHierarchyCSR(CSRGraph *csr);
+ContractionHierarchy *buildContractionHierarchy(Graph *graph);
+void freeContractionHierarchy(ContractionHierarchy *ch);
+int saveContractionHierarchy(ContractionHierarchy *ch, const char *path);
+ContractionHierarchy *loadContractionHierarchy(const char *path);
+int chShortestPath(ContractionHierarchy *ch, int s, int t, QueryWorkspace *ws, int *settledCount);
+void shortestPathContractionHierarchy(ContractionHierarchy *ch, int s, int t);
+CSRGraph *reverseCSR(CSRGraph *csr);
+long long directionOptimizingBFS(CSRGraph *csr, CSRGraph *rev, int start, int *distance, int *parent);
+void BFS_DirectionOptimizing(CSRGraph *csr, CSRGraph *rev, int start);
+void parallelBFS(CSRGraph *csr, int start, int *distance, int numThreads);
+void shortestPathBFSParallel(CSRGraph *csr, int start);
+int multiSourceDijkstra(CSRGraph *csr, const int *sources, int count, int *out, int numThreads);
+DistanceMatrix *allPairsShortestPaths(CSRGraph *csr, const char *path, int numThreads);
+void freeDistanceMatrix(DistanceMatrix *m);
+void printDistanceMatrix(DistanceMatrix *m);
+void allPairsShortestPathsJohnson(CSRGraph *csr, const char *path);
+EdgeList *loadEdgeList(const char *path);
+EdgeList *loadEdgeListText(const char *path);
+EdgeList *loadEdgeListBinary(const char *path);
+int saveEdgeListBinary(const char *path, int V, Edge edges[], int E, int directed);
+void freeEdgeList(EdgeList *list);
+Graph *createGraphFromEdges(int V, Edge edges[], int E, int directed, int withMatrix);
+int saveGraphSnapshot(const char *path, CSRGraph *csr, Edge edges[], int E, int directed);
+GraphSnapshot *openGraphSnapshot(const char *path, int verify);
+void closeGraphSnapshot(GraphSnapshot *snapshot);
+DynamicGraph *createDynamicGraph(int V, int directed);
+void freeDynamicGraph(DynamicGraph *g);
+long long dynamicGraphInsertEdges(DynamicGraph *g, Edge batch[], int count, int numThreads);
+long long dynamicGraphDeleteEdges(DynamicGraph *g, Edge batch[], int count, int numThreads);
+long long dynamicGraphUpdateWeights(DynamicGraph *g, WeightChange batch[], int count, int numThreads);
+int repairShortestPathsDynamic(DynamicGraph *g, int *dist, int *parent, WeightChange changes[], int count);
+void shortestPathDijkstraIncremental(DynamicGraph *g, int src, WeightChange changes[], int count);
+CSRGraph *createCSRFromDynamicGraph(DynamicGraph *g);
+long long bfsShortestPathsDynamic(DynamicGraph *g, int start, int *dist, int *parent);
+long long dijkstraShortestPathsDynamic(DynamicGraph *g, int src, int *dist, int *parent);
+void printDynamicGraph(DynamicGraph *g);
+void shortestPathBFSDynamic(DynamicGraph *g, int start);
+void shortestPathDijkstraDynamic(DynamicGraph *g, int src);
 
 // Queue structure for BFS and Kahn's algorithm
+// Growable ring buffer; capacity is a power of two so wrap-around is a mask
 typedef struct Queue
 {
-    int items[MAX];
-    int front;
-    int rear;
+    int *items;
+    int capacity;
+    int front; // Index of the first item
+    int count; // Number of items stored
 } Queue;
 
 // Queue functions
 void initQueue(Queue *q)
 {
-    q->front = -1;
-    q->rear = -1;
+    q->capacity = QUEUE_INITIAL_CAPACITY;
+    q->items = malloc(q->capacity * sizeof(int));
+    q->front = 0;
+    q->count = 0;
+}
+
+void freeQueue(Queue *q)
+{
+    free(q->items);
+    q->items = NULL;
+    q->capacity = 0;
+    q->count = 0;
 }
 
 int isEmptyQueue(Queue *q)
 {
-    return q->front == -1;
+    return q->count == 0;
 }
 
 void enqueue(Queue *q, int value)
 {
-    if (q->rear == MAX - 1)
-        return;
-    if (q->front == -1)
+    if (q->count == q->capacity)
+    {
+        // Double the buffer, unwrapping the items to start at index 0
+        int *items = malloc(2 * q->capacity * sizeof(int));
+        for (int i = 0; i < q->count; i++)
+            items[i] = q->items[(q->front + i) & (q->capacity - 1)];
+        free(q->items);
+        q->items = items;
+        q->capacity *= 2;
         q->front = 0;
-    q->rear++;
-    q->items[q->rear] = value;
+    }
+    q->items[(q->front + q->count) & (q->capacity - 1)] = value;
+    q->count++;
 }
 
 int dequeue(Queue *q)
@@ -124,9 +585,8 @@ int dequeue(Queue *q)
     if (isEmptyQueue(q))
         return -1;
     int item = q->items[q->front];
-    q->front++;
-    if (q->front > q->rear)
-        initQueue(q);
+    q->front = (q->front + 1) & (q->capacity - 1);
+    q->count--;
     return item;
 }
 
@@ -136,41 +596,120 @@ DSU *createDSU(int size)
     DSU *dsu = (DSU *)malloc(sizeof(DSU));
     dsu->size = size;
     dsu->parent = (int *)malloc(size * sizeof(int));
-    dsu->rank = (int *)malloc(size * sizeof(int));
     for (int i = 0; i < size; i++)
-    {
-        dsu->parent[i] = i;
-        dsu->rank[i] = 0;
-    }
+        dsu->parent[i] = -1; // Every element is a root of a set of size 1
     return dsu;
 }
 
+// Iterative find with path halving: every visited element skips to its grandparent
 int dsuFind(DSU *dsu, int x)
 {
-    if (dsu->parent[x] != x)
-        dsu->parent[x] = dsuFind(dsu, dsu->parent[x]); // Path compression
-    return dsu->parent[x];
+    int p;
+    while ((p = dsu->parent[x]) >= 0)
+    {
+        int gp = dsu->parent[p];
+        if (gp < 0)
+            return p;
+        dsu->parent[x] = gp;
+        x = gp;
+    }
+    return x;
 }
 
-void dsuUnion(DSU *dsu, int x, int y)
+// Union by size; returns 1 if x and y were in different sets
+int dsuUnion(DSU *dsu, int x, int y)
 {
     int xroot = dsuFind(dsu, x);
     int yroot = dsuFind(dsu, y);
     if (xroot == yroot)
-        return;
-    // Union by rank
-    if (dsu->rank[xroot] < dsu->rank[yroot])
+        return 0;
+    // Hang the smaller set under the larger (sizes are stored negated)
+    if (dsu->parent[xroot] > dsu->parent[yroot])
     {
-        dsu->parent[xroot] = yroot;
+        int t = xroot;
+        xroot = yroot;
+        yroot = t;
     }
-    else if (dsu->rank[xroot] > dsu->rank[yroot])
+    dsu->parent[xroot] += dsu->parent[yroot];
+    dsu->parent[yroot] = xroot;
+    return 1;
+}
+
+// Number of elements in the set containing x
+int dsuSetSize(DSU *dsu, int x)
+{
+    return -dsu->parent[dsuFind(dsu, x)];
+}
+
+// Union the endpoints of each of E edges
+// Parent slots of endpoints a few edges ahead are prefetched, since on large
+// sets nearly every find starts with a cache miss. Edges that joined two sets
+// are copied to merged if it is not NULL. Returns the number of such edges.
+int dsuUnionBatch(DSU *dsu, Edge edges[], int E, Edge *merged)
+{
+    int count = 0;
+    for (int i = 0; i < E; i++)
     {
-        dsu->parent[yroot] = xroot;
+        if (i + DSU_PREFETCH_DISTANCE < E)
+        {
+            __builtin_prefetch(&dsu->parent[edges[i + DSU_PREFETCH_DISTANCE].src]);
+            __builtin_prefetch(&dsu->parent[edges[i + DSU_PREFETCH_DISTANCE].dest]);
+        }
+        if (dsuUnion(dsu, edges[i].src, edges[i].dest))
+        {
+            if (merged)
+                merged[count] = edges[i];
+            count++;
+        }
     }
-    else
+    return count;
+}
+
+void freeDSU(DSU *dsu)
+{
+    free(dsu->parent);
+    free(dsu);
+}
+
+// Find for DSU shared between threads, with path halving done by CAS
+// A failed CAS only means another thread already shortened the path
+int dsuFindConcurrent(DSU *dsu, int x)
+{
+    while (1)
     {
-        dsu->parent[yroot] = xroot;
-        dsu->rank[xroot]++;
+        int p = __atomic_load_n(&dsu->parent[x], __ATOMIC_ACQUIRE);
+        if (p < 0)
+            return x;
+        int gp = __atomic_load_n(&dsu->parent[p], __ATOMIC_ACQUIRE);
+        if (gp < 0)
+            return p;
+        __atomic_compare_exchange_n(&dsu->parent[x], &p, gp, 0, __ATOMIC_RELEASE, __ATOMIC_RELAXED);
+        x = gp;
+    }
+}
+
+// Lock-free union for DSU shared between threads
+// The larger root is linked under the smaller one; returns 1 if the sets were merged.
+// Set sizes are not maintained, so dsuSetSize is only meaningful for sequential use.
+int dsuUnionConcurrent(DSU *dsu, int x, int y)
+{
+    while (1)
+    {
+        x = dsuFindConcurrent(dsu, x);
+        y = dsuFindConcurrent(dsu, y);
+        if (x == y)
+            return 0;
+        if (x < y)
+        {
+            int t = x;
+            x = y;
+            y = t;
+        }
+        int expected = __atomic_load_n(&dsu->parent[x], __ATOMIC_ACQUIRE);
+        if (expected >= 0)
+            continue; // x was linked by another thread
+        if (__atomic_compare_exchange_n(&dsu->parent[x], &expected, y, 0, __ATOMIC_ACQ_REL, __ATOMIC_RELAXED))
+            return 1;
     }
 }
 
@@ -178,16 +717,77 @@ void displayDSU(DSU *dsu)
 {
     printf("DSU Parent Array:\n");
     for (int i = 0; i < dsu->size; i++)
-        printf("Element %d: Parent %d\n", i, dsu->parent[i]);
-    printf("DSU Rank Array:\n");
-    for (int i = 0; i < dsu->size; i++)
-        printf("Element %d: Rank %d\n", i, dsu->rank[i]);
+    {
+        if (dsu->parent[i] < 0)
+            printf("Element %d: Root (set size %d)\n", i, -dsu->parent[i]);
+        else
+            printf("Element %d: Parent %d\n", i, dsu->parent[i]);
+    }
+}
+
+// Print a distance array, one vertex per line
+void printDistances(int *dist, int V)
+{
+    for (int i = 0; i < V; i++)
+        printf("Vertex %d: %d\n", i, dist[i]);
+}
+
+// Sum of the weights of e MST edges
+long long mstTotalWeight(Edge result[], int e)
+{
+    long long total = 0;
+    for (int i = 0; i < e; i++)
+        total += result[i].weight;
+    return total;
+}
+
+// Print MST edges under a heading, followed by the total weight
+void printMSTEdges(const char *title, Edge result[], int e)
+{
+    printf("%s:\n", title);
+    for (int i = 0; i < e; i++)
+        printf("%d - %d (w=%d)\n", result[i].src, result[i].dest, result[i].weight);
+    printf("Total weight: %lld\n", mstTotalWeight(result, e));
+}
+
+// Print a sequence of vertices on one line after a label
+void printVertexOrder(const char *label, int *order, int count)
+{
+    printf("%s: ", label);
+    for (int i = 0; i < count; i++)
+        printf("%d ", order[i]);
+    printf("\n");
 }
 
-// Create a new adjacency list node
-AdjListNode *newAdjListNode(int dest, int weight)
+// Take count consecutive nodes from the graph's arena
+// A request that does not fit the current slab starts a new one; the old slab's
+// tail is left unused
+static AdjListNode *allocAdjListNodes(Graph *graph, size_t count)
 {
-    AdjListNode *newNode = malloc(sizeof(AdjListNode));
+    NodeSlab *slab = graph->slabs;
+    if (!slab || slab->capacity - slab->used < count)
+    {
+        size_t capacity = slab ? 2 * slab->capacity : NODE_SLAB_MIN_NODES;
+        if (capacity > NODE_SLAB_MAX_NODES)
+            capacity = NODE_SLAB_MAX_NODES;
+        if (capacity < count)
+            capacity = count;
+        NodeSlab *fresh = malloc(sizeof(NodeSlab) + capacity * sizeof(AdjListNode));
+        fresh->next = slab;
+        fresh->used = 0;
+        fresh->capacity = capacity;
+        graph->slabs = slab = fresh;
+    }
+    AdjListNode *nodes = slab->nodes + slab->used;
+    slab->used += count;
+    return nodes;
+}
+
+// Create a new adjacency list node in the graph's arena
+// Nodes live until freeGraph releases the whole arena
+AdjListNode *newAdjListNode(Graph *graph, int dest, int weight)
+{
+    AdjListNode *newNode = allocAdjListNodes(graph, 1);
     newNode->dest = dest;
     newNode->weight = weight;
     newNode->next = NULL;
@@ -196,6 +796,13 @@ AdjListNode *newAdjListNode(int dest, int weight)
 
 // Create a graph with V vertices
 Graph *createGraph(int V)
+{
+    return createGraphWithMatrix(V, 1);
+}
+
+// Create a graph with V vertices, allocating the V x V matrix only if asked
+// Without the matrix memory scales with the number of edges
+Graph *createGraphWithMatrix(int V, int withMatrix)
 {
     Graph *graph = malloc(sizeof(Graph));
     graph->V = V;
@@ -205,6 +812,11 @@ Graph *createGraph(int V)
     for (int i = 0; i < V; i++)
         graph->array[i].head = NULL;
 
+    graph->slabs = NULL;
+    graph->adjMatrix = NULL;
+    if (!withMatrix)
+        return graph;
+
     // Create adjacency matrix
     graph->adjMatrix = malloc(V * sizeof(int *));
     for (int i = 0; i < V; i++)
@@ -217,18 +829,41 @@ Graph *createGraph(int V)
     return graph;
 }
 
+// Free a graph with its adjacency lists and matrix (if any)
+// The list nodes go with their slabs, without walking the lists
+void freeGraph(Graph *graph)
+{
+    if (!graph)
+        return;
+    NodeSlab *slab = graph->slabs;
+    while (slab)
+    {
+        NodeSlab *next = slab->next;
+        free(slab);
+        slab = next;
+    }
+    free(graph->array);
+    if (graph->adjMatrix)
+    {
+        for (int i = 0; i < graph->V; i++)
+            free(graph->adjMatrix[i]);
+        free(graph->adjMatrix);
+    }
+    free(graph);
+}
+
 // Add edge to adjacency list
 void addEdgeList(Graph *graph, int src, int dest, int weight, int directed)
 {
     // Add edge from src to dest
-    AdjListNode *newNode = newAdjListNode(dest, weight);
+    AdjListNode *newNode = newAdjListNode(graph, dest, weight);
     newNode->next = graph->array[src].head;
     graph->array[src].head = newNode;
 
     if (!directed)
     {
         // Add edge from dest to src
-        newNode = newAdjListNode(src, weight);
+        newNode = newAdjListNode(graph, src, weight);
         newNode->next = graph->array[dest].head;
         graph->array[dest].head = newNode;
     }
@@ -237,6 +872,8 @@ void addEdgeList(Graph *graph, int src, int dest, int weight, int directed)
 // Add edge to adjacency matrix
 void addEdgeMatrix(Graph *graph, int src, int dest, int weight, int directed)
 {
+    if (!graph->adjMatrix)
+        return;
     graph->adjMatrix[src][dest] = weight;
     if (!directed)
         graph->adjMatrix[dest][src] = weight;
@@ -261,6 +898,11 @@ void printAdjList(Graph *graph)
 // Print adjacency matrix
 void printAdjMatrix(Graph *graph)
 {
+    if (!graph->adjMatrix)
+    {
+        printf("Adjacency matrix is not stored for this graph.\n");
+        return;
+    }
     printf("\nAdjacency Matrix:\n   ");
     for (int i = 0; i < graph->V; i++)
         printf("%3d", i);
@@ -277,9 +919,7 @@ void printAdjMatrix(Graph *graph)
 // BFS using adjacency list
 void BFS_List(Graph *graph, int start)
 {
-    int visited[graph->V];
-    for (int i = 0; i < graph->V; i++)
-        visited[i] = 0;
+    int *visited = calloc(graph->V, sizeof(int));
 
     Queue q;
     initQueue(&q);
@@ -305,39 +945,59 @@ void BFS_List(Graph *graph, int start)
         }
     }
     printf("\n");
+    freeQueue(&q);
+    free(visited);
 }
 
 // DFS utility function
+// Iterative with an explicit stack so deep graphs cannot overflow the call stack
+// Visits vertices in the same order as the recursive version
 void DFS_ListUtil(Graph *graph, int v, int *visited)
 {
+    DFSFrame *frames = malloc(graph->V * sizeof(DFSFrame));
+    int depth = 0;
+
     visited[v] = 1;
     printf("%d ", v);
+    frames[depth].v = v;
+    frames[depth++].next = graph->array[v].head;
 
-    AdjListNode *pCrawl = graph->array[v].head;
-    while (pCrawl)
+    while (depth > 0)
     {
-        if (!visited[pCrawl->dest])
-            DFS_ListUtil(graph, pCrawl->dest, visited);
-        pCrawl = pCrawl->next;
+        AdjListNode *pCrawl = frames[depth - 1].next;
+        while (pCrawl && visited[pCrawl->dest])
+            pCrawl = pCrawl->next;
+        if (!pCrawl)
+        {
+            depth--;
+            continue;
+        }
+        frames[depth - 1].next = pCrawl->next;
+
+        int w = pCrawl->dest;
+        visited[w] = 1;
+        printf("%d ", w);
+        frames[depth].v = w;
+        frames[depth++].next = graph->array[w].head;
     }
+    free(frames);
 }
 
 // DFS using adjacency list
 void DFS_List(Graph *graph, int start)
 {
-    int visited[graph->V];
-    for (int i = 0; i < graph->V; i++)
-        visited[i] = 0;
+    int *visited = calloc(graph->V, sizeof(int));
 
     printf("DFS Traversal: ");
     DFS_ListUtil(graph, start, visited);
     printf("\n");
+    free(visited);
 }
 
 // Reverse the graph edges
 Graph *reverseGraph(Graph *graph)
 {
-    Graph *rev = createGraph(graph->V);
+    Graph *rev = createGraphWithMatrix(graph->V, 0);
     for (int v = 0; v < graph->V; v++)
     {
         AdjListNode *pCrawl = graph->array[v].head;
@@ -353,7 +1013,7 @@ Graph *reverseGraph(Graph *graph)
 // Convert undirected graph to directed by keeping one direction
 Graph *convertUndirectedToDirected(Graph *graph)
 {
-    Graph *dir = createGraph(graph->V);
+    Graph *dir = createGraphWithMatrix(graph->V, 0);
     for (int v = 0; v < graph->V; v++)
     {
         AdjListNode *pCrawl = graph->array[v].head;
@@ -368,46 +1028,70 @@ Graph *convertUndirectedToDirected(Graph *graph)
 }
 
 // Topological Sort using DFS
-void topologicalSortDFSUtil(Graph *graph, int v, int *visited, int *stack, int *top)
+// Iterative; frames is caller-provided scratch space for V DFS frames
+void topologicalSortDFSUtil(Graph *graph, int v, int *visited, int *stack, int *top, DFSFrame *frames)
 {
+    int depth = 0;
     visited[v] = 1;
-    AdjListNode *pCrawl = graph->array[v].head;
-    while (pCrawl)
+    frames[depth].v = v;
+    frames[depth++].next = graph->array[v].head;
+
+    while (depth > 0)
     {
-        if (!visited[pCrawl->dest])
-            topologicalSortDFSUtil(graph, pCrawl->dest, visited, stack, top);
-        pCrawl = pCrawl->next;
+        AdjListNode *pCrawl = frames[depth - 1].next;
+        while (pCrawl && visited[pCrawl->dest])
+            pCrawl = pCrawl->next;
+        if (!pCrawl)
+        {
+            // All descendants finished; v goes on the stack after them
+            stack[(*top)++] = frames[--depth].v;
+            continue;
+        }
+        frames[depth - 1].next = pCrawl->next;
+
+        int w = pCrawl->dest;
+        visited[w] = 1;
+        frames[depth].v = w;
+        frames[depth++].next = graph->array[w].head;
     }
-    stack[(*top)++] = v;
 }
 
-void topologicalSortDFS(Graph *graph)
+// Topological order using DFS, written to order (room for V vertices)
+// Returns the number of vertices in the order (always V)
+int topologicalOrderDFS(Graph *graph, int *order)
 {
     int *stack = malloc(graph->V * sizeof(int));
     int topIdx = 0;
-    int visited[graph->V];
-    for (int i = 0; i < graph->V; i++)
-        visited[i] = 0;
+    int *visited = calloc(graph->V, sizeof(int));
+    DFSFrame *frames = malloc(graph->V * sizeof(DFSFrame));
 
     for (int i = 0; i < graph->V; i++)
     {
         if (!visited[i])
-            topologicalSortDFSUtil(graph, i, visited, stack, &topIdx);
+            topologicalSortDFSUtil(graph, i, visited, stack, &topIdx, frames);
     }
 
-    printf("Topological Sort (DFS): ");
-    for (int i = topIdx - 1; i >= 0; i--)
-        printf("%d ", stack[i]);
-    printf("\n");
+    for (int i = 0; i < topIdx; i++)
+        order[i] = stack[topIdx - 1 - i];
+    free(frames);
+    free(visited);
     free(stack);
+    return topIdx;
 }
 
-// Topological Sort using BFS (Kahn's Algorithm)
-void topologicalSortBFS(Graph *graph)
+void topologicalSortDFS(Graph *graph)
 {
-    int in_degree[graph->V];
-    for (int i = 0; i < graph->V; i++)
-        in_degree[i] = 0;
+    int *order = malloc(graph->V * sizeof(int));
+    int cnt = topologicalOrderDFS(graph, order);
+    printVertexOrder("Topological Sort (DFS)", order, cnt);
+    free(order);
+}
+
+// Topological order using BFS (Kahn's Algorithm), written to order (room for V vertices)
+// Returns the number of vertices ordered; less than V means the graph has a cycle
+int topologicalOrderBFS(Graph *graph, int *order)
+{
+    int *in_degree = calloc(graph->V, sizeof(int));
 
     // Compute in-degree
     for (int u = 0; u < graph->V; u++)
@@ -427,12 +1111,10 @@ void topologicalSortBFS(Graph *graph)
             enqueue(&q, i);
 
     int cnt = 0;
-    int topOrder[graph->V];
-
     while (!isEmptyQueue(&q))
     {
         int u = dequeue(&q);
-        topOrder[cnt++] = u;
+        order[cnt++] = u;
 
         AdjListNode *pCrawl = graph->array[u].head;
         while (pCrawl)
@@ -443,71 +1125,316 @@ void topologicalSortBFS(Graph *graph)
         }
     }
 
+    freeQueue(&q);
+    free(in_degree);
+    return cnt;
+}
+
+// Topological Sort using BFS (Kahn's Algorithm)
+void topologicalSortBFS(Graph *graph)
+{
+    int *topOrder = malloc(graph->V * sizeof(int));
+    int cnt = topologicalOrderBFS(graph, topOrder);
+
     if (cnt != graph->V)
-    {
         printf("Graph has a cycle. Topological sort not possible.\n");
-        return;
-    }
-
-    printf("Topological Sort (BFS/Kahn's): ");
-    for (int i = 0; i < cnt; i++)
-        printf("%d ", topOrder[i]);
-    printf("\n");
+    else
+        printVertexOrder("Topological Sort (BFS/Kahn's)", topOrder, cnt);
+    free(topOrder);
 }
 
-// Shortest Path BFS (for unweighted graphs)
-void shortestPathBFS(Graph *graph, int start)
+// Strongly connected components with Tarjan's algorithm (iterative)
+// Fills comp[v] with the component of v and returns the number of components.
+// Components are numbered in topological order of the condensation: every
+// edge between two components goes from the lower id to the higher id.
+int sccTarjan(Graph *graph, int *comp)
 {
-    int distance[graph->V];
-    for (int i = 0; i < graph->V; i++)
-        distance[i] = -1;
+    int V = graph->V;
+    int *index = malloc(V * sizeof(int)); // DFS discovery index, -1 if unvisited
+    int *low = malloc(V * sizeof(int));
+    int *stack = malloc(V * sizeof(int)); // Vertices of components not yet closed
+    char *onStack = calloc(V, sizeof(char));
+    DFSFrame *frames = malloc(V * sizeof(DFSFrame));
+    int nextIndex = 0, top = 0, count = 0;
 
-    Queue q;
-    initQueue(&q);
-    distance[start] = 0;
-    enqueue(&q, start);
+    for (int v = 0; v < V; v++)
+        index[v] = -1;
 
-    while (!isEmptyQueue(&q))
+    for (int r = 0; r < V; r++)
     {
-        int u = dequeue(&q);
-        AdjListNode *pCrawl = graph->array[u].head;
-        while (pCrawl)
+        if (index[r] != -1)
+            continue;
+        int depth = 0;
+        index[r] = low[r] = nextIndex++;
+        stack[top++] = r;
+        onStack[r] = 1;
+        frames[depth].v = r;
+        frames[depth++].next = graph->array[r].head;
+
+        while (depth > 0)
         {
-            if (distance[pCrawl->dest] == -1)
+            DFSFrame *f = &frames[depth - 1];
+            int u = f->v;
+            if (f->next)
             {
-                distance[pCrawl->dest] = distance[u] + 1;
-                enqueue(&q, pCrawl->dest);
+                int w = f->next->dest;
+                f->next = f->next->next;
+                if (index[w] == -1)
+                {
+                    index[w] = low[w] = nextIndex++;
+                    stack[top++] = w;
+                    onStack[w] = 1;
+                    frames[depth].v = w;
+                    frames[depth++].next = graph->array[w].head;
+                }
+                else if (onStack[w] && index[w] < low[u])
+                {
+                    low[u] = index[w];
+                }
+                continue;
             }
-            pCrawl = pCrawl->next;
+
+            // u is finished; it closes a component if nothing below reached higher up
+            depth--;
+            if (low[u] == index[u])
+            {
+                int w;
+                do
+                {
+                    w = stack[--top];
+                    onStack[w] = 0;
+                    comp[w] = count;
+                } while (w != u);
+                count++;
+            }
+            if (depth > 0 && low[u] < low[frames[depth - 1].v])
+                low[frames[depth - 1].v] = low[u];
         }
     }
 
-    printf("Shortest distances from vertex %d (BFS):\n", start);
-    for (int i = 0; i < graph->V; i++)
-        printf("Vertex %d: %d\n", i, distance[i]);
-}
+    // Tarjan closes sink components first; flip ids into topological order
+    for (int v = 0; v < V; v++)
+        comp[v] = count - 1 - comp[v];
 
-// Create a new MinHeap node
-MinHeapNode *newMinHeapNode(int v, int dist)
-{
-    MinHeapNode *minHeapNode = malloc(sizeof(MinHeapNode));
-    minHeapNode->v = v;
-    minHeapNode->dist = dist;
-    return minHeapNode;
+    free(frames);
+    free(onStack);
+    free(stack);
+    free(low);
+    free(index);
+    return count;
 }
 
-// Create a MinHeap
-MinHeap *createMinHeap(int capacity)
+// Strongly connected components with Kosaraju's algorithm
+// A DFS over the graph gives vertices by decreasing finish time; searching
+// reverseGraph in that order collects one component per search.
+// Fills comp and returns the count with the same numbering rule as sccTarjan
+int sccKosaraju(Graph *graph, int *comp)
 {
-    MinHeap *minHeap = malloc(sizeof(MinHeap));
-    minHeap->pos = malloc(capacity * sizeof(int));
-    minHeap->size = 0;
-    minHeap->capacity = capacity;
-    minHeap->array = malloc(capacity * sizeof(MinHeapNode *));
-    return minHeap;
-}
+    int V = graph->V;
+    int *order = malloc(V * sizeof(int));
+    int *stack = malloc(V * sizeof(int));
+    topologicalOrderDFS(graph, order); // Decreasing finish time
+    Graph *rev = reverseGraph(graph);
 
-// Swap two MinHeapNodes
+    for (int v = 0; v < V; v++)
+        comp[v] = -1;
+
+    int count = 0;
+    for (int i = 0; i < V; i++)
+    {
+        int r = order[i];
+        if (comp[r] != -1)
+            continue;
+        int top = 0;
+        comp[r] = count;
+        stack[top++] = r;
+        while (top > 0)
+        {
+            int u = stack[--top];
+            for (AdjListNode *pCrawl = rev->array[u].head; pCrawl; pCrawl = pCrawl->next)
+            {
+                if (comp[pCrawl->dest] == -1)
+                {
+                    comp[pCrawl->dest] = count;
+                    stack[top++] = pCrawl->dest;
+                }
+            }
+        }
+        count++;
+    }
+
+    freeGraph(rev);
+    free(stack);
+    free(order);
+    return count;
+}
+
+// Condensation of graph: one vertex per component (count components in comp)
+// and one directed edge per pair of adjacent components, weighted by the
+// lightest edge between them. The result is a DAG (no adjacency matrix).
+Graph *condenseGraph(Graph *graph, int *comp, int count)
+{
+    int V = graph->V;
+    Graph *dag = createGraphWithMatrix(count, 0);
+
+    // Group vertices by component (counting sort)
+    int *start = calloc(count + 1, sizeof(int));
+    int *members = malloc(V * sizeof(int));
+    for (int v = 0; v < V; v++)
+        start[comp[v] + 1]++;
+    for (int c = 0; c < count; c++)
+        start[c + 1] += start[c];
+    int *fill = malloc((count ? count : 1) * sizeof(int));
+    memcpy(fill, start, count * sizeof(int));
+    for (int v = 0; v < V; v++)
+        members[fill[comp[v]]++] = v;
+
+    // seen[d] == c + 1 means edge c -> d was already added, as edgeTo[d]
+    int *seen = calloc(count ? count : 1, sizeof(int));
+    AdjListNode **edgeTo = malloc((count ? count : 1) * sizeof(AdjListNode *));
+    for (int c = 0; c < count; c++)
+    {
+        for (int i = start[c]; i < start[c + 1]; i++)
+        {
+            for (AdjListNode *pCrawl = graph->array[members[i]].head; pCrawl; pCrawl = pCrawl->next)
+            {
+                int d = comp[pCrawl->dest];
+                if (d == c)
+                    continue;
+                if (seen[d] == c + 1)
+                {
+                    if (pCrawl->weight < edgeTo[d]->weight)
+                        edgeTo[d]->weight = pCrawl->weight;
+                    continue;
+                }
+                seen[d] = c + 1;
+                addEdgeList(dag, c, d, pCrawl->weight, 1);
+                edgeTo[d] = dag->array[c].head;
+            }
+        }
+    }
+
+    free(edgeTo);
+    free(seen);
+    free(fill);
+    free(members);
+    free(start);
+    return dag;
+}
+
+// Print the strongly connected components and a topological order of the condensation
+void stronglyConnectedComponents(Graph *graph)
+{
+    int V = graph->V;
+    int *comp = malloc(V * sizeof(int));
+    int count = sccTarjan(graph, comp);
+
+    printf("Strongly connected components: %d\n", count);
+    int *start = calloc(count + 1, sizeof(int));
+    int *members = malloc(V * sizeof(int));
+    for (int v = 0; v < V; v++)
+        start[comp[v] + 1]++;
+    for (int c = 0; c < count; c++)
+        start[c + 1] += start[c];
+    for (int v = 0; v < V; v++) // Vertices of c end up in members[start[c - 1] .. start[c] - 1]
+        members[start[comp[v]]++] = v;
+    char label[32];
+    for (int c = 0; c < count; c++)
+    {
+        int first = c ? start[c - 1] : 0;
+        snprintf(label, sizeof(label), "Component %d", c);
+        printVertexOrder(label, members + first, start[c] - first);
+    }
+
+    Graph *dag = condenseGraph(graph, comp, count);
+    printf("Condensed graph:");
+    printAdjList(dag);
+    topologicalSortBFS(dag);
+
+    freeGraph(dag);
+    free(members);
+    free(start);
+    free(comp);
+}
+
+// BFS shortest paths (for unweighted graphs)
+// Fills dist (-1 if unreachable) and, if not NULL, parent (-1 for start and unreachable)
+void bfsShortestPaths(Graph *graph, int start, int *dist, int *parent)
+{
+    for (int i = 0; i < graph->V; i++)
+    {
+        dist[i] = -1;
+        if (parent)
+            parent[i] = -1;
+    }
+
+    Queue q;
+    initQueue(&q);
+    dist[start] = 0;
+    enqueue(&q, start);
+
+    while (!isEmptyQueue(&q))
+    {
+        int u = dequeue(&q);
+        AdjListNode *pCrawl = graph->array[u].head;
+        while (pCrawl)
+        {
+            if (dist[pCrawl->dest] == -1)
+            {
+                dist[pCrawl->dest] = dist[u] + 1;
+                if (parent)
+                    parent[pCrawl->dest] = u;
+                enqueue(&q, pCrawl->dest);
+            }
+            pCrawl = pCrawl->next;
+        }
+    }
+    freeQueue(&q);
+}
+
+// Shortest Path BFS (for unweighted graphs)
+void shortestPathBFS(Graph *graph, int start)
+{
+    int *distance = malloc(graph->V * sizeof(int));
+    bfsShortestPaths(graph, start, distance, NULL);
+
+    printf("Shortest distances from vertex %d (BFS):\n", start);
+    printDistances(distance, graph->V);
+    free(distance);
+}
+
+// Create a new MinHeap node
+MinHeapNode *newMinHeapNode(int v, int dist)
+{
+    MinHeapNode *minHeapNode = malloc(sizeof(MinHeapNode));
+    minHeapNode->v = v;
+    minHeapNode->dist = dist;
+    return minHeapNode;
+}
+
+// Create a MinHeap
+MinHeap *createMinHeap(int capacity)
+{
+    MinHeap *minHeap = malloc(sizeof(MinHeap));
+    minHeap->pos = malloc(capacity * sizeof(int));
+    minHeap->size = 0;
+    minHeap->capacity = capacity;
+    minHeap->array = malloc(capacity * sizeof(MinHeapNode *));
+    return minHeap;
+}
+
+// Free a MinHeap along with the nodes still stored in it
+// Nodes returned by extractMin are owned by the caller
+void freeMinHeap(MinHeap *minHeap)
+{
+    for (int i = 0; i < minHeap->size; i++)
+        free(minHeap->array[i]);
+    free(minHeap->array);
+    free(minHeap->pos);
+    free(minHeap);
+}
+
+// Swap two MinHeapNodes
 void swapMinHeapNode(MinHeapNode **a, MinHeapNode **b)
 {
     MinHeapNode *t = *a;
@@ -583,13 +1510,158 @@ void decreaseKey(MinHeap *minHeap, int v, int dist)
     }
 }
 
+// Create a d-ary heap of {dist, v} entries (d >= 2)
+DaryHeap *createDaryHeap(int capacity, int d)
+{
+    DaryHeap *heap = malloc(sizeof(DaryHeap));
+    heap->capacity = capacity > 0 ? capacity : 1;
+    heap->items = malloc(heap->capacity * sizeof(HeapEntry));
+    heap->size = 0;
+    heap->d = d >= 2 ? d : 2;
+    return heap;
+}
+
+void freeDaryHeap(DaryHeap *heap)
+{
+    free(heap->items);
+    free(heap);
+}
+
+int isEmptyDaryHeap(DaryHeap *heap)
+{
+    return heap->size == 0;
+}
+
+// Insert an entry, growing the array when full
+void daryHeapPush(DaryHeap *heap, int dist, int v)
+{
+    if (heap->size == heap->capacity)
+    {
+        heap->capacity *= 2;
+        heap->items = realloc(heap->items, heap->capacity * sizeof(HeapEntry));
+    }
+
+    // Sift up by moving parents down into the hole
+    int i = heap->size++;
+    while (i > 0)
+    {
+        int p = (i - 1) / heap->d;
+        if (heap->items[p].dist <= dist)
+            break;
+        heap->items[i] = heap->items[p];
+        i = p;
+    }
+    heap->items[i].dist = dist;
+    heap->items[i].v = v;
+}
+
+// Remove and return the entry with the smallest dist (heap must not be empty)
+HeapEntry daryHeapPop(DaryHeap *heap)
+{
+    HeapEntry top = heap->items[0];
+    HeapEntry last = heap->items[--heap->size];
+    int n = heap->size;
+    int d = heap->d;
+
+    // Sift down by moving the smallest child up into the hole
+    int i = 0;
+    while (1)
+    {
+        int first = d * i + 1;
+        if (first >= n)
+            break;
+        int end = first + d < n ? first + d : n;
+        int best = first;
+        for (int c = first + 1; c < end; c++)
+            if (heap->items[c].dist < heap->items[best].dist)
+                best = c;
+        if (heap->items[best].dist >= last.dist)
+            break;
+        heap->items[i] = heap->items[best];
+        i = best;
+    }
+    if (n > 0)
+        heap->items[i] = last;
+    return top;
+}
+
+// Create an empty radix heap (all keys must be >= the last key popped)
+RadixHeap *createRadixHeap(void)
+{
+    RadixHeap *heap = calloc(1, sizeof(RadixHeap));
+    return heap;
+}
+
+void freeRadixHeap(RadixHeap *heap)
+{
+    for (int b = 0; b < RADIX_HEAP_BUCKETS; b++)
+        free(heap->bucket[b]);
+    free(heap);
+}
+
+// Bucket of a key: 0 if equal to last, else 1 + index of the highest bit differing from last
+static int radixHeapBucket(RadixHeap *heap, unsigned int key)
+{
+    return key == heap->last ? 0 : 32 - __builtin_clz(key ^ heap->last);
+}
+
+static void radixHeapAppend(RadixHeap *heap, int b, HeapEntry entry)
+{
+    if (heap->count[b] == heap->capacity[b])
+    {
+        heap->capacity[b] = heap->capacity[b] ? 2 * heap->capacity[b] : 16;
+        heap->bucket[b] = realloc(heap->bucket[b], heap->capacity[b] * sizeof(HeapEntry));
+    }
+    heap->bucket[b][heap->count[b]++] = entry;
+}
+
+// Insert an entry with a non-negative key that is not below the last popped key
+void radixHeapPush(RadixHeap *heap, int dist, int v)
+{
+    HeapEntry entry = {dist, v};
+    radixHeapAppend(heap, radixHeapBucket(heap, (unsigned int)dist), entry);
+    heap->size++;
+}
+
+// Remove and return an entry with the smallest key (heap must not be empty)
+HeapEntry radixHeapPop(RadixHeap *heap)
+{
+    if (heap->count[0] == 0)
+    {
+        // Move the minimum of the first non-empty bucket to last and
+        // redistribute that bucket; every entry lands in a lower bucket
+        int b = 1;
+        while (heap->count[b] == 0)
+            b++;
+        unsigned int min = (unsigned int)heap->bucket[b][0].dist;
+        for (int i = 1; i < heap->count[b]; i++)
+            if ((unsigned int)heap->bucket[b][i].dist < min)
+                min = (unsigned int)heap->bucket[b][i].dist;
+        heap->last = min;
+
+        int n = heap->count[b];
+        heap->count[b] = 0;
+        for (int i = 0; i < n; i++)
+        {
+            HeapEntry entry = heap->bucket[b][i];
+            radixHeapAppend(heap, radixHeapBucket(heap, (unsigned int)entry.dist), entry);
+        }
+    }
+    heap->size--;
+    return heap->bucket[0][--heap->count[0]];
+}
+
 // Dijkstra's algorithm
-void shortestPathDijkstra(Graph *graph, int src)
+// Fills dist (INT_MAX if unreachable) and, if not NULL, parent (-1 for src and unreachable)
+void dijkstraShortestPaths(Graph *graph, int src, int *dist, int *parent)
 {
     int V = graph->V;
-    int dist[V];
     for (int v = 0; v < V; v++)
+    {
         dist[v] = INT_MAX;
+        if (parent)
+            parent[v] = -1;
+    }
     dist[src] = 0;
 
     MinHeap *minHeap = createMinHeap(V);
@@ -606,6 +1678,7 @@ void shortestPathDijkstra(Graph *graph, int src)
     {
         MinHeapNode *minHeapNode = extractMin(minHeap);
         int u = minHeapNode->v;
+        free(minHeapNode);
 
         AdjListNode *pCrawl = graph->array[u].head;
         while (pCrawl)
@@ -614,178 +1687,4805 @@ void shortestPathDijkstra(Graph *graph, int src)
             if (minHeap->pos[v] < minHeap->size && dist[u] != INT_MAX && pCrawl->weight + dist[u] < dist[v])
             {
                 dist[v] = dist[u] + pCrawl->weight;
+                if (parent)
+                    parent[v] = u;
                 decreaseKey(minHeap, v, dist[v]);
             }
             pCrawl = pCrawl->next;
         }
     }
+    freeMinHeap(minHeap);
+}
+
+void shortestPathDijkstra(Graph *graph, int src)
+{
+    int *dist = malloc(graph->V * sizeof(int));
+    dijkstraShortestPaths(graph, src, dist, NULL);
 
     printf("Dijkstra's shortest paths from vertex %d:\n", src);
-    for (int i = 0; i < V; i++)
-        printf("Vertex %d: %d\n", i, dist[i]);
+    printDistances(dist, graph->V);
+    free(dist);
 }
 
 // Bellman-Ford algorithm
-void shortestPathBellmanFord(Graph *graph, int V, Edge edges[], int E, int src)
+// Fills dist (INT_MAX if unreachable) and, if not NULL, parent (-1 for src and unreachable)
+// Stops early once a pass relaxes nothing, since later passes could not change anything
+// Returns 0 if a negative weight cycle is reachable from src, 1 otherwise
+int bellmanFordShortestPaths(int V, Edge edges[], int E, int src, int *dist, int *parent)
 {
-    int dist[V];
     for (int i = 0; i < V; i++)
+    {
         dist[i] = INT_MAX;
+        if (parent)
+            parent[i] = -1;
+    }
     dist[src] = 0;
 
     for (int i = 1; i < V; i++)
     {
-        for (int j = 0; j < E; j++)
+        int changed = 0;
+        for (int j = 0; j < E; j++)
+        {
+            int u = edges[j].src;
+            int v = edges[j].dest;
+            int weight = edges[j].weight;
+            if (dist[u] != INT_MAX && dist[u] + weight < dist[v])
+            {
+                dist[v] = dist[u] + weight;
+                if (parent)
+                    parent[v] = u;
+                changed = 1;
+            }
+        }
+        if (!changed)
+            return 1;
+    }
+
+    // Check for negative-weight cycles
+    for (int j = 0; j < E; j++)
+    {
+        int u = edges[j].src;
+        int v = edges[j].dest;
+        int weight = edges[j].weight;
+        if (dist[u] != INT_MAX && dist[u] + weight < dist[v])
+            return 0;
+    }
+    return 1;
+}
+
+void shortestPathBellmanFord(Graph *graph, int V, Edge edges[], int E, int src)
+{
+    int *dist = malloc(V * sizeof(int));
+    if (!bellmanFordShortestPaths(V, edges, E, src, dist, NULL))
+    {
+        printf("Graph contains negative weight cycle\n");
+        free(dist);
+        return;
+    }
+
+    printf("Bellman-Ford shortest paths from vertex %d:\n", src);
+    printDistances(dist, V);
+    free(dist);
+}
+
+// Queue-based Bellman-Ford (SPFA) on CSR graph
+// Only vertices whose distance just dropped are rescanned. A negative cycle is
+// reported once some tentative shortest path uses V or more arcs.
+// Fills dist and parent like bellmanFordShortestPaths; returns 0 on a negative cycle
+int spfaShortestPathsCSR(CSRGraph *csr, int src, int *dist, int *parent)
+{
+    int V = csr->V;
+    int *arcs = calloc(V, sizeof(int)); // Arcs on the tentative path to each vertex
+    int *inQueue = calloc(V, sizeof(int));
+    for (int i = 0; i < V; i++)
+    {
+        dist[i] = INT_MAX;
+        if (parent)
+            parent[i] = -1;
+    }
+    dist[src] = 0;
+
+    Queue q;
+    initQueue(&q);
+    enqueue(&q, src);
+    inQueue[src] = 1;
+    int ok = 1;
+
+    while (ok && !isEmptyQueue(&q))
+    {
+        int u = dequeue(&q);
+        inQueue[u] = 0;
+        for (int k = csr->offsets[u]; k < csr->offsets[u + 1]; k++)
+        {
+            int v = csr->dest[k];
+            if (dist[u] + csr->weight[k] >= dist[v])
+                continue;
+            dist[v] = dist[u] + csr->weight[k];
+            if (parent)
+                parent[v] = u;
+            arcs[v] = arcs[u] + 1;
+            if (arcs[v] >= V)
+            {
+                ok = 0;
+                break;
+            }
+            if (!inQueue[v])
+            {
+                enqueue(&q, v);
+                inQueue[v] = 1;
+            }
+        }
+    }
+
+    freeQueue(&q);
+    free(inQueue);
+    free(arcs);
+    return ok;
+}
+
+// SPFA over an edge array (edges are directed src -> dest, as in bellmanFordShortestPaths)
+int spfaShortestPaths(int V, Edge edges[], int E, int src, int *dist, int *parent)
+{
+    CSRGraph *csr = createCSRFromEdges(V, edges, E, 1);
+    int ok = spfaShortestPathsCSR(csr, src, dist, parent);
+    freeCSR(csr);
+    return ok;
+}
+
+void shortestPathSPFA(int V, Edge edges[], int E, int src)
+{
+    int *dist = malloc(V * sizeof(int));
+    if (!spfaShortestPaths(V, edges, E, src, dist, NULL))
+    {
+        printf("Graph contains negative weight cycle\n");
+        free(dist);
+        return;
+    }
+
+    printf("SPFA shortest paths from vertex %d:\n", src);
+    printDistances(dist, V);
+    free(dist);
+}
+
+// State shared by the threads of a parallel Bellman-Ford run
+// Each vertex label packs distance (high 32 bits) and parent (low 32 bits) so
+// both are replaced by a single compare-and-swap
+typedef struct BellmanFordShared
+{
+    Edge *edges;
+    int E;
+    int V;
+    long long *label;
+    int numThreads;
+    int *changed; // Whether each thread relaxed an edge this pass
+    int pass;
+    int done;
+    int negativeCycle;
+    pthread_barrier_t barrier;
+} BellmanFordShared;
+
+// Work item for one thread of a parallel Bellman-Ford run
+typedef struct BellmanFordTask
+{
+    BellmanFordShared *shared;
+    int id;
+} BellmanFordTask;
+
+static long long packLabel(int dist, int parent)
+{
+    return (long long)(((unsigned long long)(unsigned int)dist << 32) | (unsigned int)parent);
+}
+
+static int labelDist(long long label)
+{
+    return (int)(label >> 32);
+}
+
+// Lower the distance in *slot to dist (with parent); returns 1 if it was lowered
+static int atomicRelaxLabel(long long *slot, int dist, int parent)
+{
+    long long next = packLabel(dist, parent);
+    long long cur = __atomic_load_n(slot, __ATOMIC_RELAXED);
+    while (dist < labelDist(cur))
+    {
+        if (__atomic_compare_exchange_n(slot, &cur, next, 1, __ATOMIC_RELAXED, __ATOMIC_RELAXED))
+            return 1;
+    }
+    return 0;
+}
+
+// Bellman-Ford worker: relaxes its slice of the edge array once per pass
+// Thread 0 ends the run after a pass without changes, or reports a negative
+// cycle if the V-th pass still relaxes an edge
+static void *bellmanFordWorker(void *arg)
+{
+    BellmanFordTask *task = arg;
+    BellmanFordShared *sh = task->shared;
+    int lo = (int)((long long)sh->E * task->id / sh->numThreads);
+    int hi = (int)((long long)sh->E * (task->id + 1) / sh->numThreads);
+
+    while (1)
+    {
+        int changed = 0;
+        for (int j = lo; j < hi; j++)
+        {
+            int u = sh->edges[j].src;
+            int du = labelDist(__atomic_load_n(&sh->label[u], __ATOMIC_RELAXED));
+            if (du != INT_MAX && atomicRelaxLabel(&sh->label[sh->edges[j].dest], du + sh->edges[j].weight, u))
+                changed = 1;
+        }
+        sh->changed[task->id] = changed;
+        pthread_barrier_wait(&sh->barrier);
+
+        if (task->id == 0)
+        {
+            int any = 0;
+            for (int t = 0; t < sh->numThreads; t++)
+                any |= sh->changed[t];
+            sh->pass++;
+            if (!any)
+                sh->done = 1;
+            else if (sh->pass >= sh->V)
+                sh->done = sh->negativeCycle = 1;
+        }
+        pthread_barrier_wait(&sh->barrier);
+        if (sh->done)
+            break;
+    }
+    return NULL;
+}
+
+// Multi-threaded Bellman-Ford over the edge array
+// Same results and negative cycle detection as bellmanFordShortestPaths
+int bellmanFordShortestPathsParallel(int V, Edge edges[], int E, int src, int *dist, int *parent, int numThreads)
+{
+    if (numThreads < 1)
+        numThreads = 1;
+
+    BellmanFordShared sh;
+    sh.edges = edges;
+    sh.E = E;
+    sh.V = V;
+    sh.label = malloc(V * sizeof(long long));
+    sh.numThreads = numThreads;
+    sh.changed = calloc(numThreads, sizeof(int));
+    sh.pass = 0;
+    sh.done = 0;
+    sh.negativeCycle = 0;
+    pthread_barrier_init(&sh.barrier, NULL, numThreads);
+
+    for (int i = 0; i < V; i++)
+        sh.label[i] = packLabel(INT_MAX, -1);
+    sh.label[src] = packLabel(0, -1);
+
+    BellmanFordTask *tasks = malloc(numThreads * sizeof(BellmanFordTask));
+    for (int t = 0; t < numThreads; t++)
+    {
+        tasks[t].shared = &sh;
+        tasks[t].id = t;
+    }
+    runThreads(bellmanFordWorker, tasks, sizeof(BellmanFordTask), numThreads);
+
+    for (int i = 0; i < V; i++)
+    {
+        dist[i] = labelDist(sh.label[i]);
+        if (parent)
+            parent[i] = (int)(unsigned int)sh.label[i];
+    }
+
+    pthread_barrier_destroy(&sh.barrier);
+    free(tasks);
+    free(sh.changed);
+    free(sh.label);
+    return !sh.negativeCycle;
+}
+
+void shortestPathBellmanFordParallel(int V, Edge edges[], int E, int src)
+{
+    int *dist = malloc(V * sizeof(int));
+    if (!bellmanFordShortestPathsParallel(V, edges, E, src, dist, NULL, getThreadCount()))
+    {
+        printf("Graph contains negative weight cycle\n");
+        free(dist);
+        return;
+    }
+
+    printf("Parallel Bellman-Ford shortest paths from vertex %d:\n", src);
+    printDistances(dist, V);
+    free(dist);
+}
+
+// Prim's algorithm, storing the MST edges in result (room for V - 1 edges)
+// Uses the indexed MinHeap so each step costs O(log V) instead of a scan over key[]
+// Edge weights are taken from key[] so the adjacency matrix is not needed
+// Returns the number of MST edges (the tree spanning vertex 0's component)
+int primMSTEdges(Graph *graph, Edge result[])
+{
+    int V = graph->V;
+    int *parent = malloc(V * sizeof(int));
+    int *key = malloc(V * sizeof(int));
+    for (int i = 0; i < V; i++)
+    {
+        key[i] = INT_MAX;
+        parent[i] = -1;
+    }
+
+    MinHeap *minHeap = createMinHeap(V);
+    for (int v = 0; v < V; v++)
+    {
+        minHeap->array[v] = newMinHeapNode(v, key[v]);
+        minHeap->pos[v] = v;
+    }
+    minHeap->size = V;
+
+    key[0] = 0;
+    decreaseKey(minHeap, 0, key[0]);
+
+    while (!isEmpty(minHeap))
+    {
+        MinHeapNode *minHeapNode = extractMin(minHeap);
+        int u = minHeapNode->v;
+        free(minHeapNode);
+        if (key[u] == INT_MAX)
+            break; // Remaining vertices are not reachable from vertex 0
+
+        // Update key and parent index of adjacent vertices
+        AdjListNode *pCrawl = graph->array[u].head;
+        while (pCrawl)
+        {
+            int v = pCrawl->dest;
+            if (minHeap->pos[v] < minHeap->size && pCrawl->weight < key[v])
+            {
+                key[v] = pCrawl->weight;
+                parent[v] = u;
+                decreaseKey(minHeap, v, key[v]);
+            }
+            pCrawl = pCrawl->next;
+        }
+    }
+
+    int e = 0;
+    for (int i = 1; i < V; i++)
+        if (key[i] != INT_MAX)
+        {
+            result[e].src = parent[i];
+            result[e].dest = i;
+            result[e++].weight = key[i];
+        }
+
+    freeMinHeap(minHeap);
+    free(parent);
+    free(key);
+    return e;
+}
+
+// Prim's algorithm
+void primMST(Graph *graph)
+{
+    Edge *result = malloc(graph->V * sizeof(Edge));
+    int e = primMSTEdges(graph, result);
+    printMSTEdges("Prim's MST", result, e);
+    free(result);
+}
+
+// Number of worker threads used by the parallel routines
+int getThreadCount(void)
+{
+    long n = sysconf(_SC_NPROCESSORS_ONLN);
+    return n > 0 ? (int)n : 1;
+}
+
+// Run worker on each task in its own thread and wait for all of them
+// tasks points to numThreads consecutive task structs of taskSize bytes
+void runThreads(void *(*worker)(void *), void *tasks, size_t taskSize, int numThreads)
+{
+    if (numThreads == 1)
+    {
+        worker(tasks);
+        return;
+    }
+    pthread_t *threads = malloc(numThreads * sizeof(pthread_t));
+    for (int t = 0; t < numThreads; t++)
+        pthread_create(&threads[t], NULL, worker, (char *)tasks + t * taskSize);
+    for (int t = 0; t < numThreads; t++)
+        pthread_join(threads[t], NULL);
+    free(threads);
+}
+
+// Wall clock time in seconds, for benchmarks of threaded code
+double wallClockSeconds(void)
+{
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ts.tv_sec + ts.tv_nsec / 1e9;
+}
+
+// Sort edges by weight using Bubble Sort (original Kruskal sort, kept for benchmarks)
+void bubbleSortEdges(Edge edges[], int E)
+{
+    for (int i = 0; i < E - 1; i++)
+    {
+        for (int j = 0; j < E - i - 1; j++)
+        {
+            if (edges[j].weight > edges[j + 1].weight)
+            {
+                Edge temp = edges[j];
+                edges[j] = edges[j + 1];
+                edges[j + 1] = temp;
+            }
+        }
+    }
+}
+
+// Work item for one thread of a radix sort pass
+typedef struct RadixSortTask
+{
+    Edge *src;
+    Edge *dst;
+    int begin;
+    int end;
+    int shift;
+    int *count; // RADIX_BUCKETS counters (later offsets) for this slice
+} RadixSortTask;
+
+// Map a signed weight to an unsigned key with the same ordering
+static unsigned int radixKey(int weight)
+{
+    return (unsigned int)weight ^ 0x80000000u;
+}
+
+// Count digits of this thread's slice
+static void *radixHistogramWorker(void *arg)
+{
+    RadixSortTask *task = arg;
+    for (int b = 0; b < RADIX_BUCKETS; b++)
+        task->count[b] = 0;
+    for (int i = task->begin; i < task->end; i++)
+        task->count[(radixKey(task->src[i].weight) >> task->shift) & (RADIX_BUCKETS - 1)]++;
+    return NULL;
+}
+
+// Scatter this thread's slice to its precomputed offsets (stable)
+static void *radixScatterWorker(void *arg)
+{
+    RadixSortTask *task = arg;
+    for (int i = task->begin; i < task->end; i++)
+    {
+        int b = (radixKey(task->src[i].weight) >> task->shift) & (RADIX_BUCKETS - 1);
+        task->dst[task->count[b]++] = task->src[i];
+    }
+    return NULL;
+}
+
+// Stable LSD radix sort of edges by weight, O(E) per 8-bit digit
+// Arrays of at least PARALLEL_SORT_THRESHOLD edges are split across numThreads threads
+void radixSortEdges(Edge edges[], int E, int numThreads)
+{
+    if (E < 2)
+        return;
+    if (numThreads < 1 || E < PARALLEL_SORT_THRESHOLD)
+        numThreads = 1;
+
+    Edge *buffer = malloc(E * sizeof(Edge));
+    int *counts = malloc(numThreads * RADIX_BUCKETS * sizeof(int));
+    RadixSortTask *tasks = malloc(numThreads * sizeof(RadixSortTask));
+    Edge *src = edges, *dst = buffer;
+
+    for (int shift = 0; shift < 32; shift += RADIX_BITS)
+    {
+        for (int t = 0; t < numThreads; t++)
+        {
+            tasks[t].src = src;
+            tasks[t].dst = dst;
+            tasks[t].begin = (int)((long long)E * t / numThreads);
+            tasks[t].end = (int)((long long)E * (t + 1) / numThreads);
+            tasks[t].shift = shift;
+            tasks[t].count = counts + t * RADIX_BUCKETS;
+        }
+        runThreads(radixHistogramWorker, tasks, sizeof(RadixSortTask), numThreads);
+
+        // Skip the pass if every edge has the same digit (common for small weights)
+        int skip = 0;
+        for (int b = 0; b < RADIX_BUCKETS && !skip; b++)
+        {
+            int total = 0;
+            for (int t = 0; t < numThreads; t++)
+                total += counts[t * RADIX_BUCKETS + b];
+            skip = (total == E);
+        }
+        if (skip)
+            continue;
+
+        // Turn counts into starting offsets, bucket-major then thread order
+        int running = 0;
+        for (int b = 0; b < RADIX_BUCKETS; b++)
+        {
+            for (int t = 0; t < numThreads; t++)
+            {
+                int c = counts[t * RADIX_BUCKETS + b];
+                counts[t * RADIX_BUCKETS + b] = running;
+                running += c;
+            }
+        }
+        runThreads(radixScatterWorker, tasks, sizeof(RadixSortTask), numThreads);
+
+        Edge *tmp = src;
+        src = dst;
+        dst = tmp;
+    }
+
+    if (src != edges)
+        memcpy(edges, src, E * sizeof(Edge));
+    free(tasks);
+    free(counts);
+    free(buffer);
+}
+
+// Kruskal's algorithm, storing the MST edges in result (room for V - 1 edges)
+// Returns the number of MST edges; edges[] is left sorted by weight
+int kruskalMSTEdges(int V, Edge edges[], int E, Edge result[])
+{
+    // Sort edges based on weight using radix sort
+    radixSortEdges(edges, E, getThreadCount());
+
+    // Initialize DSU
+    DSU *dsu = createDSU(V);
+
+    int e = 0;
+    int i = 0;
+    while (e < V - 1 && i < E)
+    {
+        Edge next_edge = edges[i++];
+        int x = dsuFind(dsu, next_edge.src);
+        int y = dsuFind(dsu, next_edge.dest);
+
+        if (x != y)
+        {
+            result[e++] = next_edge;
+            dsuUnion(dsu, x, y);
+        }
+    }
+
+    freeDSU(dsu);
+    return e;
+}
+
+// Kruskal's algorithm
+void kruskalMST(Graph *graph, Edge edges[], int E)
+{
+    Edge *result = malloc(graph->V * sizeof(Edge));
+    int e = kruskalMSTEdges(graph->V, edges, E, result);
+    printMSTEdges("Kruskal's MST", result, e);
+    free(result);
+}
+
+// Work item for one thread of a Boruvka round
+typedef struct BoruvkaTask
+{
+    DSU *dsu;
+    Edge *edges;
+    unsigned long long *cheapest; // Packed (weight key, edge index) per component root
+    char *inMST;
+    int begin;
+    int end;
+    int merged; // Number of unions done by this thread
+} BoruvkaTask;
+
+// Atomically lower *slot to value if value is smaller
+static void atomicMinU64(unsigned long long *slot, unsigned long long value)
+{
+    unsigned long long cur = __atomic_load_n(slot, __ATOMIC_RELAXED);
+    while (value < cur && !__atomic_compare_exchange_n(slot, &cur, value, 1, __ATOMIC_RELAXED, __ATOMIC_RELAXED))
+        ;
+}
+
+// For each edge in the slice, offer it as the cheapest edge of both endpoint components
+// Ties are broken by edge index so all components agree on one total order
+static void *boruvkaCheapestWorker(void *arg)
+{
+    BoruvkaTask *task = arg;
+    for (int i = task->begin; i < task->end; i++)
+    {
+        int ru = dsuFindConcurrent(task->dsu, task->edges[i].src);
+        int rv = dsuFindConcurrent(task->dsu, task->edges[i].dest);
+        if (ru == rv)
+            continue;
+        unsigned long long packed = ((unsigned long long)radixKey(task->edges[i].weight) << 32) | (unsigned int)i;
+        atomicMinU64(&task->cheapest[ru], packed);
+        atomicMinU64(&task->cheapest[rv], packed);
+    }
+    return NULL;
+}
+
+// Merge every component in the slice along its cheapest edge
+static void *boruvkaMergeWorker(void *arg)
+{
+    BoruvkaTask *task = arg;
+    task->merged = 0;
+    for (int v = task->begin; v < task->end; v++)
+    {
+        unsigned long long packed = task->cheapest[v];
+        if (packed == ULLONG_MAX)
+            continue;
+        task->cheapest[v] = ULLONG_MAX;
+        int i = (int)(packed & 0xFFFFFFFFu);
+        // Both endpoints may pick the same edge; only the successful union keeps it
+        if (dsuUnionConcurrent(task->dsu, task->edges[i].src, task->edges[i].dest))
+        {
+            task->inMST[i] = 1;
+            task->merged++;
+        }
+    }
+    return NULL;
+}
+
+// Parallel Boruvka's algorithm over an edge list (edges treated as undirected)
+// Stores the minimum spanning forest in result (room for V - 1 edges) and returns its size
+int boruvkaMSTEdges(int V, Edge edges[], int E, Edge result[], int numThreads)
+{
+    if (numThreads < 1)
+        numThreads = 1;
+    DSU *dsu = createDSU(V);
+    unsigned long long *cheapest = malloc(V * sizeof(unsigned long long));
+    char *inMST = calloc(E > 0 ? E : 1, 1);
+    BoruvkaTask *tasks = malloc(numThreads * sizeof(BoruvkaTask));
+    for (int v = 0; v < V; v++)
+        cheapest[v] = ULLONG_MAX;
+    for (int t = 0; t < numThreads; t++)
+    {
+        tasks[t].dsu = dsu;
+        tasks[t].edges = edges;
+        tasks[t].cheapest = cheapest;
+        tasks[t].inMST = inMST;
+    }
+
+    int merged = 1;
+    while (merged)
+    {
+        for (int t = 0; t < numThreads; t++)
+        {
+            tasks[t].begin = (int)((long long)E * t / numThreads);
+            tasks[t].end = (int)((long long)E * (t + 1) / numThreads);
+        }
+        runThreads(boruvkaCheapestWorker, tasks, sizeof(BoruvkaTask), numThreads);
+
+        for (int t = 0; t < numThreads; t++)
+        {
+            tasks[t].begin = (int)((long long)V * t / numThreads);
+            tasks[t].end = (int)((long long)V * (t + 1) / numThreads);
+        }
+        runThreads(boruvkaMergeWorker, tasks, sizeof(BoruvkaTask), numThreads);
+
+        merged = 0;
+        for (int t = 0; t < numThreads; t++)
+            merged += tasks[t].merged;
+    }
+
+    int e = 0;
+    for (int i = 0; i < E; i++)
+        if (inMST[i])
+            result[e++] = edges[i];
+
+    free(tasks);
+    free(inMST);
+    free(cheapest);
+    freeDSU(dsu);
+    return e;
+}
+
+// Boruvka's algorithm (parallel)
+void boruvkaMST(Graph *graph, Edge edges[], int E)
+{
+    Edge *result = malloc(graph->V * sizeof(Edge));
+    int e = boruvkaMSTEdges(graph->V, edges, E, result, getThreadCount());
+    printMSTEdges("Boruvka's MST", result, e);
+    free(result);
+}
+
+// Build a CSR graph from an adjacency list graph
+// Arcs keep the same order as in the adjacency lists
+CSRGraph *createCSRFromGraph(Graph *graph)
+{
+    CSRGraph *csr = malloc(sizeof(CSRGraph));
+    csr->V = graph->V;
+    csr->offsets = malloc((graph->V + 1) * sizeof(int));
+
+    // Count out-degree of each vertex
+    csr->offsets[0] = 0;
+    for (int u = 0; u < graph->V; u++)
+    {
+        int deg = 0;
+        AdjListNode *pCrawl = graph->array[u].head;
+        while (pCrawl)
+        {
+            deg++;
+            pCrawl = pCrawl->next;
+        }
+        csr->offsets[u + 1] = csr->offsets[u] + deg;
+    }
+
+    csr->E = csr->offsets[graph->V];
+    csr->dest = malloc(csr->E * sizeof(int));
+    csr->weight = malloc(csr->E * sizeof(int));
+
+    for (int u = 0; u < graph->V; u++)
+    {
+        int k = csr->offsets[u];
+        AdjListNode *pCrawl = graph->array[u].head;
+        while (pCrawl)
+        {
+            csr->dest[k] = pCrawl->dest;
+            csr->weight[k] = pCrawl->weight;
+            k++;
+            pCrawl = pCrawl->next;
+        }
+    }
+    return csr;
+}
+
+// Build a CSR graph directly from an edge list
+// Edges are placed newest first so the arc order matches addEdgeList
+CSRGraph *createCSRFromEdges(int V, Edge edges[], int E, int directed)
+{
+    CSRGraph *csr = malloc(sizeof(CSRGraph));
+    csr->V = V;
+    csr->offsets = malloc((V + 1) * sizeof(int));
+    for (int i = 0; i <= V; i++)
+        csr->offsets[i] = 0;
+
+    // Count out-degree of each vertex (shifted by one for the prefix sum)
+    for (int i = 0; i < E; i++)
+    {
+        csr->offsets[edges[i].src + 1]++;
+        if (!directed)
+            csr->offsets[edges[i].dest + 1]++;
+    }
+    for (int i = 0; i < V; i++)
+        csr->offsets[i + 1] += csr->offsets[i];
+
+    csr->E = csr->offsets[V];
+    csr->dest = malloc(csr->E * sizeof(int));
+    csr->weight = malloc(csr->E * sizeof(int));
+
+    int *cursor = malloc(V * sizeof(int));
+    for (int i = 0; i < V; i++)
+        cursor[i] = csr->offsets[i];
+
+    for (int i = E - 1; i >= 0; i--)
+    {
+        int k = cursor[edges[i].src]++;
+        csr->dest[k] = edges[i].dest;
+        csr->weight[k] = edges[i].weight;
+        if (!directed)
+        {
+            k = cursor[edges[i].dest]++;
+            csr->dest[k] = edges[i].src;
+            csr->weight[k] = edges[i].weight;
+        }
+    }
+    free(cursor);
+    return csr;
+}
+
+// Free a CSR graph
+void freeCSR(CSRGraph *csr)
+{
+    if (!csr)
+        return;
+    free(csr->offsets);
+    free(csr->dest);
+    free(csr->weight);
+    free(csr);
+}
+
+// Reverse the arcs of a CSR graph (CSR counterpart of reverseGraph)
+CSRGraph *reverseCSR(CSRGraph *csr)
+{
+    CSRGraph *rev = malloc(sizeof(CSRGraph));
+    rev->V = csr->V;
+    rev->E = csr->E;
+    rev->offsets = calloc(csr->V + 1, sizeof(int));
+    rev->dest = malloc(csr->E * sizeof(int));
+    rev->weight = malloc(csr->E * sizeof(int));
+
+    for (int k = 0; k < csr->E; k++)
+        rev->offsets[csr->dest[k] + 1]++;
+    for (int i = 0; i < csr->V; i++)
+        rev->offsets[i + 1] += rev->offsets[i];
+
+    int *cursor = malloc(csr->V * sizeof(int));
+    for (int i = 0; i < csr->V; i++)
+        cursor[i] = rev->offsets[i];
+    for (int u = 0; u < csr->V; u++)
+    {
+        for (int k = csr->offsets[u]; k < csr->offsets[u + 1]; k++)
+        {
+            int r = cursor[csr->dest[k]]++;
+            rev->dest[r] = u;
+            rev->weight[r] = csr->weight[k];
+        }
+    }
+    free(cursor);
+    return rev;
+}
+
+// Print CSR graph in the same layout as printAdjList
+void printCSR(CSRGraph *csr)
+{
+    for (int v = 0; v < csr->V; v++)
+    {
+        printf("\n Adjacency list of vertex %d\n head ", v);
+        for (int k = csr->offsets[v]; k < csr->offsets[v + 1]; k++)
+            printf("-> %d(w=%d)", csr->dest[k], csr->weight[k]);
+        printf("\n");
+    }
+}
+
+// BFS using CSR graph
+void BFS_CSR(CSRGraph *csr, int start)
+{
+    int *visited = calloc(csr->V, sizeof(int));
+
+    Queue q;
+    initQueue(&q);
+    visited[start] = 1;
+    enqueue(&q, start);
+
+    printf("BFS Traversal (CSR): ");
+
+    while (!isEmptyQueue(&q))
+    {
+        int v = dequeue(&q);
+        printf("%d ", v);
+
+        for (int k = csr->offsets[v]; k < csr->offsets[v + 1]; k++)
+        {
+            if (!visited[csr->dest[k]])
+            {
+                visited[csr->dest[k]] = 1;
+                enqueue(&q, csr->dest[k]);
+            }
+        }
+    }
+    printf("\n");
+    freeQueue(&q);
+    free(visited);
+}
+
+// DFS utility function for CSR graph (iterative, explicit stack)
+void DFS_CSRUtil(CSRGraph *csr, int v, int *visited)
+{
+    DFSFrameCSR *frames = malloc(csr->V * sizeof(DFSFrameCSR));
+    int depth = 0;
+
+    visited[v] = 1;
+    printf("%d ", v);
+    frames[depth].v = v;
+    frames[depth++].next = csr->offsets[v];
+
+    while (depth > 0)
+    {
+        DFSFrameCSR *f = &frames[depth - 1];
+        int end = csr->offsets[f->v + 1];
+        while (f->next < end && visited[csr->dest[f->next]])
+            f->next++;
+        if (f->next == end)
+        {
+            depth--;
+            continue;
+        }
+
+        int w = csr->dest[f->next++];
+        visited[w] = 1;
+        printf("%d ", w);
+        frames[depth].v = w;
+        frames[depth++].next = csr->offsets[w];
+    }
+    free(frames);
+}
+
+// DFS using CSR graph
+void DFS_CSR(CSRGraph *csr, int start)
+{
+    int *visited = calloc(csr->V, sizeof(int));
+
+    printf("DFS Traversal (CSR): ");
+    DFS_CSRUtil(csr, start, visited);
+    printf("\n");
+    free(visited);
+}
+
+// Topological Sort using DFS on CSR graph
+// Iterative; frames is caller-provided scratch space for V DFS frames
+void topologicalSortDFS_CSRUtil(CSRGraph *csr, int v, int *visited, int *stack, int *top, DFSFrameCSR *frames)
+{
+    int depth = 0;
+    visited[v] = 1;
+    frames[depth].v = v;
+    frames[depth++].next = csr->offsets[v];
+
+    while (depth > 0)
+    {
+        DFSFrameCSR *f = &frames[depth - 1];
+        int end = csr->offsets[f->v + 1];
+        while (f->next < end && visited[csr->dest[f->next]])
+            f->next++;
+        if (f->next == end)
+        {
+            stack[(*top)++] = f->v;
+            depth--;
+            continue;
+        }
+
+        int w = csr->dest[f->next++];
+        visited[w] = 1;
+        frames[depth].v = w;
+        frames[depth++].next = csr->offsets[w];
+    }
+}
+
+// Topological order using DFS on CSR graph (see topologicalOrderDFS)
+int topologicalOrderDFS_CSR(CSRGraph *csr, int *order)
+{
+    int *stack = malloc(csr->V * sizeof(int));
+    int topIdx = 0;
+    int *visited = calloc(csr->V, sizeof(int));
+    DFSFrameCSR *frames = malloc(csr->V * sizeof(DFSFrameCSR));
+
+    for (int i = 0; i < csr->V; i++)
+    {
+        if (!visited[i])
+            topologicalSortDFS_CSRUtil(csr, i, visited, stack, &topIdx, frames);
+    }
+
+    for (int i = 0; i < topIdx; i++)
+        order[i] = stack[topIdx - 1 - i];
+    free(frames);
+    free(visited);
+    free(stack);
+    return topIdx;
+}
+
+void topologicalSortDFS_CSR(CSRGraph *csr)
+{
+    int *order = malloc(csr->V * sizeof(int));
+    int cnt = topologicalOrderDFS_CSR(csr, order);
+    printVertexOrder("Topological Sort (DFS, CSR)", order, cnt);
+    free(order);
+}
+
+// Topological order using Kahn's Algorithm on CSR graph (see topologicalOrderBFS)
+int topologicalOrderBFS_CSR(CSRGraph *csr, int *order)
+{
+    int *in_degree = calloc(csr->V, sizeof(int));
+
+    // Compute in-degree
+    for (int k = 0; k < csr->E; k++)
+        in_degree[csr->dest[k]]++;
+
+    Queue q;
+    initQueue(&q);
+    for (int i = 0; i < csr->V; i++)
+        if (in_degree[i] == 0)
+            enqueue(&q, i);
+
+    int cnt = 0;
+    while (!isEmptyQueue(&q))
+    {
+        int u = dequeue(&q);
+        order[cnt++] = u;
+
+        for (int k = csr->offsets[u]; k < csr->offsets[u + 1]; k++)
+            if (--in_degree[csr->dest[k]] == 0)
+                enqueue(&q, csr->dest[k]);
+    }
+
+    freeQueue(&q);
+    free(in_degree);
+    return cnt;
+}
+
+// Topological Sort using BFS (Kahn's Algorithm) on CSR graph
+void topologicalSortBFS_CSR(CSRGraph *csr)
+{
+    int *topOrder = malloc(csr->V * sizeof(int));
+    int cnt = topologicalOrderBFS_CSR(csr, topOrder);
+
+    if (cnt != csr->V)
+        printf("Graph has a cycle. Topological sort not possible.\n");
+    else
+        printVertexOrder("Topological Sort (BFS/Kahn's, CSR)", topOrder, cnt);
+    free(topOrder);
+}
+
+// BFS shortest paths on CSR graph (see bfsShortestPaths)
+void bfsShortestPathsCSR(CSRGraph *csr, int start, int *dist, int *parent)
+{
+    for (int i = 0; i < csr->V; i++)
+    {
+        dist[i] = -1;
+        if (parent)
+            parent[i] = -1;
+    }
+
+    Queue q;
+    initQueue(&q);
+    dist[start] = 0;
+    enqueue(&q, start);
+
+    while (!isEmptyQueue(&q))
+    {
+        int u = dequeue(&q);
+        for (int k = csr->offsets[u]; k < csr->offsets[u + 1]; k++)
+        {
+            if (dist[csr->dest[k]] == -1)
+            {
+                dist[csr->dest[k]] = dist[u] + 1;
+                if (parent)
+                    parent[csr->dest[k]] = u;
+                enqueue(&q, csr->dest[k]);
+            }
+        }
+    }
+    freeQueue(&q);
+}
+
+// Shortest Path BFS (for unweighted graphs) on CSR graph
+void shortestPathBFS_CSR(CSRGraph *csr, int start)
+{
+    int *distance = malloc(csr->V * sizeof(int));
+    bfsShortestPathsCSR(csr, start, distance, NULL);
+
+    printf("Shortest distances from vertex %d (BFS, CSR):\n", start);
+    printDistances(distance, csr->V);
+    free(distance);
+}
+
+// Dijkstra's algorithm on CSR graph (see dijkstraShortestPaths)
+void dijkstraShortestPathsCSR(CSRGraph *csr, int src, int *dist, int *parent)
+{
+    int V = csr->V;
+    for (int v = 0; v < V; v++)
+    {
+        dist[v] = INT_MAX;
+        if (parent)
+            parent[v] = -1;
+    }
+    dist[src] = 0;
+
+    MinHeap *minHeap = createMinHeap(V);
+    for (int v = 0; v < V; v++)
+    {
+        minHeap->array[v] = newMinHeapNode(v, dist[v]);
+        minHeap->pos[v] = v;
+    }
+    minHeap->size = V;
+
+    decreaseKey(minHeap, src, dist[src]);
+
+    while (!isEmpty(minHeap))
+    {
+        MinHeapNode *minHeapNode = extractMin(minHeap);
+        int u = minHeapNode->v;
+        free(minHeapNode);
+
+        for (int k = csr->offsets[u]; k < csr->offsets[u + 1]; k++)
+        {
+            int v = csr->dest[k];
+            if (minHeap->pos[v] < minHeap->size && dist[u] != INT_MAX && csr->weight[k] + dist[u] < dist[v])
+            {
+                dist[v] = dist[u] + csr->weight[k];
+                if (parent)
+                    parent[v] = u;
+                decreaseKey(minHeap, v, dist[v]);
+            }
+        }
+    }
+    freeMinHeap(minHeap);
+}
+
+void shortestPathDijkstraCSR(CSRGraph *csr, int src)
+{
+    int *dist = malloc(csr->V * sizeof(int));
+    dijkstraShortestPathsCSR(csr, src, dist, NULL);
+
+    printf("Dijkstra's shortest paths from vertex %d (CSR):\n", src);
+    printDistances(dist, csr->V);
+    free(dist);
+}
+
+// Dijkstra's algorithm on CSR graph using a d-ary heap with lazy deletion
+// A vertex is pushed again whenever its distance improves and stale entries are
+// skipped when popped, so there is no decrease-key and no per-node allocation.
+// heap may be NULL, or a caller-owned heap reused across calls (its arity is kept)
+void dijkstraShortestPathsDary(CSRGraph *csr, int src, int *dist, int *parent, int d, DaryHeap *heap)
+{
+    int V = csr->V;
+    for (int v = 0; v < V; v++)
+    {
+        dist[v] = INT_MAX;
+        if (parent)
+            parent[v] = -1;
+    }
+    dist[src] = 0;
+
+    DaryHeap *h = heap ? heap : createDaryHeap(V, d);
+    h->size = 0;
+    daryHeapPush(h, 0, src);
+
+    while (!isEmptyDaryHeap(h))
+    {
+        HeapEntry top = daryHeapPop(h);
+        int u = top.v;
+        if (top.dist > dist[u])
+            continue; // Stale entry
+
+        for (int k = csr->offsets[u]; k < csr->offsets[u + 1]; k++)
+        {
+            int v = csr->dest[k];
+            int nd = dist[u] + csr->weight[k];
+            if (nd < dist[v])
+            {
+                dist[v] = nd;
+                if (parent)
+                    parent[v] = u;
+                daryHeapPush(h, nd, v);
+            }
+        }
+    }
+
+    if (!heap)
+        freeDaryHeap(h);
+}
+
+void shortestPathDijkstraDary(CSRGraph *csr, int src, int d)
+{
+    int *dist = malloc(csr->V * sizeof(int));
+    dijkstraShortestPathsDary(csr, src, dist, NULL, d, NULL);
+
+    printf("Dijkstra's shortest paths from vertex %d (%d-ary heap, CSR):\n", src, d);
+    printDistances(dist, csr->V);
+    free(dist);
+}
+
+// Smallest and largest arc weight of a CSR graph (0 and 0 if it has no arcs)
+static void csrWeightRange(CSRGraph *csr, int *minW, int *maxW)
+{
+    *minW = 0;
+    *maxW = 0;
+    for (int k = 0; k < csr->E; k++)
+    {
+        if (k == 0 || csr->weight[k] < *minW)
+            *minW = csr->weight[k];
+        if (k == 0 || csr->weight[k] > *maxW)
+            *maxW = csr->weight[k];
+    }
+}
+
+// Dijkstra's algorithm on CSR graph using a radix heap (non-negative integer weights)
+// Dijkstra pops keys in non-decreasing order, which is all a radix heap needs
+void dijkstraShortestPathsRadix(CSRGraph *csr, int src, int *dist, int *parent)
+{
+    int V = csr->V;
+    for (int v = 0; v < V; v++)
+    {
+        dist[v] = INT_MAX;
+        if (parent)
+            parent[v] = -1;
+    }
+    dist[src] = 0;
+
+    RadixHeap *heap = createRadixHeap();
+    radixHeapPush(heap, 0, src);
+
+    while (heap->size > 0)
+    {
+        HeapEntry top = radixHeapPop(heap);
+        int u = top.v;
+        if (top.dist > dist[u])
+            continue; // Stale entry
+
+        for (int k = csr->offsets[u]; k < csr->offsets[u + 1]; k++)
+        {
+            int v = csr->dest[k];
+            int nd = dist[u] + csr->weight[k];
+            if (nd < dist[v])
+            {
+                dist[v] = nd;
+                if (parent)
+                    parent[v] = u;
+                radixHeapPush(heap, nd, v);
+            }
+        }
+    }
+    freeRadixHeap(heap);
+}
+
+// Dijkstra's algorithm on CSR graph using Dial's buckets (small non-negative weights)
+// Pending labels always lie in [d, d + maxW], so maxW + 1 circular buckets suffice
+void dijkstraShortestPathsDial(CSRGraph *csr, int src, int *dist, int *parent)
+{
+    int V = csr->V;
+    int minW, maxW;
+    csrWeightRange(csr, &minW, &maxW);
+    int numBuckets = maxW + 1;
+
+    int **bucket = calloc(numBuckets, sizeof(int *));
+    int *count = calloc(numBuckets, sizeof(int));
+    int *capacity = calloc(numBuckets, sizeof(int));
+
+    for (int v = 0; v < V; v++)
+    {
+        dist[v] = INT_MAX;
+        if (parent)
+            parent[v] = -1;
+    }
+    dist[src] = 0;
+    bucket[0] = malloc(16 * sizeof(int));
+    capacity[0] = 16;
+    bucket[0][count[0]++] = src;
+    long long pending = 1;
+
+    for (int d = 0; pending > 0; d++)
+    {
+        int b = d % numBuckets;
+        // Zero-weight arcs may append to the bucket being scanned
+        for (int i = 0; i < count[b]; i++)
+        {
+            int u = bucket[b][i];
+            pending--;
+            if (dist[u] != d)
+                continue; // Stale entry
+
+            for (int k = csr->offsets[u]; k < csr->offsets[u + 1]; k++)
+            {
+                int v = csr->dest[k];
+                int nd = d + csr->weight[k];
+                if (nd < dist[v])
+                {
+                    dist[v] = nd;
+                    if (parent)
+                        parent[v] = u;
+                    int nb = nd % numBuckets;
+                    if (count[nb] == capacity[nb])
+                    {
+                        capacity[nb] = capacity[nb] ? 2 * capacity[nb] : 16;
+                        bucket[nb] = realloc(bucket[nb], capacity[nb] * sizeof(int));
+                    }
+                    bucket[nb][count[nb]++] = v;
+                    pending++;
+                }
+            }
+        }
+        count[b] = 0;
+    }
+
+    for (int b = 0; b < numBuckets; b++)
+        free(bucket[b]);
+    free(bucket);
+    free(count);
+    free(capacity);
+}
+
+// Dijkstra's algorithm on CSR graph with the priority queue chosen at call time
+// Returns 0 (and leaves dist untouched) if the queue needs non-negative weights and the graph has a negative one
+int dijkstraShortestPathsQueue(CSRGraph *csr, int src, int *dist, int *parent, DijkstraQueue queue)
+{
+    int minW, maxW;
+    csrWeightRange(csr, &minW, &maxW);
+    if (minW < 0 && queue != DIJKSTRA_INDEXED_HEAP)
+        return 0;
+
+    switch (queue)
+    {
+    case DIJKSTRA_INDEXED_HEAP:
+        dijkstraShortestPathsCSR(csr, src, dist, parent);
+        break;
+    case DIJKSTRA_DARY_HEAP:
+        dijkstraShortestPathsDary(csr, src, dist, parent, DARY_HEAP_DEFAULT_ARITY, NULL);
+        break;
+    case DIJKSTRA_RADIX_HEAP:
+        dijkstraShortestPathsRadix(csr, src, dist, parent);
+        break;
+    case DIJKSTRA_DIAL:
+        dijkstraShortestPathsDial(csr, src, dist, parent);
+        break;
+    }
+    return 1;
+}
+
+void shortestPathDijkstraQueue(CSRGraph *csr, int src, DijkstraQueue queue)
+{
+    static const char *names[] = {"indexed MinHeap", "d-ary heap", "radix heap", "Dial's buckets"};
+    int *dist = malloc(csr->V * sizeof(int));
+    if (!dijkstraShortestPathsQueue(csr, src, dist, NULL, queue))
+    {
+        printf("This priority queue requires non-negative edge weights.\n");
+        free(dist);
+        return;
+    }
+
+    printf("Dijkstra's shortest paths from vertex %d (%s, CSR):\n", src, names[queue]);
+    printDistances(dist, csr->V);
+    free(dist);
+}
+
+// Prim's algorithm on CSR graph (see primMSTEdges)
+int primMSTEdgesCSR(CSRGraph *csr, Edge result[])
+{
+    int V = csr->V;
+    int *parent = malloc(V * sizeof(int));
+    int *key = malloc(V * sizeof(int));
+    for (int i = 0; i < V; i++)
+    {
+        key[i] = INT_MAX;
+        parent[i] = -1;
+    }
+
+    MinHeap *minHeap = createMinHeap(V);
+    for (int v = 0; v < V; v++)
+    {
+        minHeap->array[v] = newMinHeapNode(v, key[v]);
+        minHeap->pos[v] = v;
+    }
+    minHeap->size = V;
+
+    key[0] = 0;
+    decreaseKey(minHeap, 0, key[0]);
+
+    while (!isEmpty(minHeap))
+    {
+        MinHeapNode *minHeapNode = extractMin(minHeap);
+        int u = minHeapNode->v;
+        free(minHeapNode);
+        if (key[u] == INT_MAX)
+            break; // Remaining vertices are not reachable from vertex 0
+
+        // Update key and parent index of adjacent vertices
+        for (int k = csr->offsets[u]; k < csr->offsets[u + 1]; k++)
+        {
+            int v = csr->dest[k];
+            if (minHeap->pos[v] < minHeap->size && csr->weight[k] < key[v])
+            {
+                key[v] = csr->weight[k];
+                parent[v] = u;
+                decreaseKey(minHeap, v, key[v]);
+            }
+        }
+    }
+
+    int e = 0;
+    for (int i = 1; i < V; i++)
+        if (key[i] != INT_MAX)
+        {
+            result[e].src = parent[i];
+            result[e].dest = i;
+            result[e++].weight = key[i];
+        }
+
+    freeMinHeap(minHeap);
+    free(parent);
+    free(key);
+    return e;
+}
+
+// Prim's algorithm on CSR graph
+void primMST_CSR(CSRGraph *csr)
+{
+    Edge *result = malloc(csr->V * sizeof(Edge));
+    int e = primMSTEdgesCSR(csr, result);
+    printMSTEdges("Prim's MST (CSR)", result, e);
+    free(result);
+}
+
+// Direction-optimizing BFS
+// Expands the frontier top-down while it is small, and switches to bottom-up
+// (each unvisited vertex scans its in-arcs in rev for a frontier parent) once the
+// frontier's out-arcs exceed 1/DOBFS_ALPHA of the arcs left to explore.
+// rev is the reversed graph; pass csr itself for undirected graphs.
+// Fills distance (-1 if unreachable) and parent (-1 for start and unreachable).
+// Returns the number of arcs inspected.
+long long directionOptimizingBFS(CSRGraph *csr, CSRGraph *rev, int start, int *distance, int *parent)
+{
+    int V = csr->V;
+    int words = (V + 63) / 64;
+    unsigned long long *frontier = malloc(words * sizeof(unsigned long long));
+    int *queue = malloc(V * sizeof(int));
+    int *nextQueue = malloc(V * sizeof(int));
+
+    for (int i = 0; i < V; i++)
+    {
+        distance[i] = -1;
+        parent[i] = -1;
+    }
+    distance[start] = 0;
+    queue[0] = start;
+    int queueSize = 1;
+
+    long long inspected = 0;
+    long long unexploredArcs = csr->E - (csr->offsets[start + 1] - csr->offsets[start]);
+    int bottomUp = 0;
+
+    for (int level = 0; queueSize > 0; level++)
+    {
+        int nextSize = 0;
+        long long nextArcs = 0;
+
+        if (bottomUp)
+        {
+            for (int w = 0; w < words; w++)
+                frontier[w] = 0;
+            for (int i = 0; i < queueSize; i++)
+                frontier[queue[i] >> 6] |= 1ULL << (queue[i] & 63);
+
+            for (int v = 0; v < V; v++)
+            {
+                if (distance[v] != -1)
+                    continue;
+                for (int k = rev->offsets[v]; k < rev->offsets[v + 1]; k++)
+                {
+                    int u = rev->dest[k];
+                    inspected++;
+                    if (frontier[u >> 6] & (1ULL << (u & 63)))
+                    {
+                        distance[v] = level + 1;
+                        parent[v] = u;
+                        nextQueue[nextSize++] = v;
+                        nextArcs += csr->offsets[v + 1] - csr->offsets[v];
+                        break;
+                    }
+                }
+            }
+        }
+        else
+        {
+            for (int i = 0; i < queueSize; i++)
+            {
+                int u = queue[i];
+                for (int k = csr->offsets[u]; k < csr->offsets[u + 1]; k++)
+                {
+                    int v = csr->dest[k];
+                    inspected++;
+                    if (distance[v] == -1)
+                    {
+                        distance[v] = level + 1;
+                        parent[v] = u;
+                        nextQueue[nextSize++] = v;
+                        nextArcs += csr->offsets[v + 1] - csr->offsets[v];
+                    }
+                }
+            }
+        }
+
+        // Pick the direction for the next level
+        unexploredArcs -= nextArcs;
+        if (!bottomUp && nextArcs > unexploredArcs / DOBFS_ALPHA)
+            bottomUp = 1;
+        else if (bottomUp && nextSize < queueSize && nextSize < V / DOBFS_BETA)
+            bottomUp = 0;
+
+        int *tmp = queue;
+        queue = nextQueue;
+        nextQueue = tmp;
+        queueSize = nextSize;
+    }
+
+    free(nextQueue);
+    free(queue);
+    free(frontier);
+    return inspected;
+}
+
+// Direction-optimizing BFS from start, printing distances and parents
+void BFS_DirectionOptimizing(CSRGraph *csr, CSRGraph *rev, int start)
+{
+    int *distance = malloc(csr->V * sizeof(int));
+    int *parent = malloc(csr->V * sizeof(int));
+    long long inspected = directionOptimizingBFS(csr, rev, start, distance, parent);
+
+    printf("Direction-optimizing BFS from vertex %d:\n", start);
+    for (int i = 0; i < csr->V; i++)
+        printf("Vertex %d: distance %d, parent %d\n", i, distance[i], parent[i]);
+    printf("Arcs inspected: %lld (of %d)\n", inspected, csr->E);
+
+    free(parent);
+    free(distance);
+}
+
+// State shared by the threads of a parallel BFS
+typedef struct ParallelBFSShared
+{
+    CSRGraph *csr;
+    int *distance;
+    unsigned long long *visited; // One bit per vertex, set atomically
+    int *frontier;
+    int *nextFrontier;
+    int frontierSize;
+    int nextIndex; // Next unclaimed frontier position
+    int level;
+    int numThreads;
+    int *localSizes; // Next-frontier size found by each thread
+    pthread_barrier_t barrier;
+} ParallelBFSShared;
+
+// Work item for one thread of a parallel BFS
+typedef struct ParallelBFSTask
+{
+    ParallelBFSShared *shared;
+    int id;
+} ParallelBFSTask;
+
+// Level-synchronous BFS worker
+// Each level: claim frontier chunks, collect newly visited vertices in a local
+// buffer, then copy the local buffer into the shared next frontier
+static void *parallelBFSWorker(void *arg)
+{
+    ParallelBFSTask *task = arg;
+    ParallelBFSShared *sh = task->shared;
+    CSRGraph *csr = sh->csr;
+    int localCap = 1024;
+    int *local = malloc(localCap * sizeof(int));
+
+    while (sh->frontierSize > 0)
+    {
+        int localSize = 0;
+        int i;
+        while ((i = __atomic_fetch_add(&sh->nextIndex, PARALLEL_BFS_CHUNK, __ATOMIC_RELAXED)) < sh->frontierSize)
+        {
+            int end = i + PARALLEL_BFS_CHUNK < sh->frontierSize ? i + PARALLEL_BFS_CHUNK : sh->frontierSize;
+            for (; i < end; i++)
+            {
+                int u = sh->frontier[i];
+                for (int k = csr->offsets[u]; k < csr->offsets[u + 1]; k++)
+                {
+                    int v = csr->dest[k];
+                    unsigned long long bit = 1ULL << (v & 63);
+                    if (__atomic_load_n(&sh->visited[v >> 6], __ATOMIC_RELAXED) & bit)
+                        continue;
+                    if (__atomic_fetch_or(&sh->visited[v >> 6], bit, __ATOMIC_RELAXED) & bit)
+                        continue; // Another thread claimed v first
+                    sh->distance[v] = sh->level + 1;
+                    if (localSize == localCap)
+                    {
+                        localCap *= 2;
+                        local = realloc(local, localCap * sizeof(int));
+                    }
+                    local[localSize++] = v;
+                }
+            }
+        }
+        sh->localSizes[task->id] = localSize;
+        pthread_barrier_wait(&sh->barrier);
+
+        int offset = 0;
+        for (int t = 0; t < task->id; t++)
+            offset += sh->localSizes[t];
+        memcpy(sh->nextFrontier + offset, local, localSize * sizeof(int));
+        pthread_barrier_wait(&sh->barrier);
+
+        // One thread advances the level while the others wait
+        if (task->id == 0)
+        {
+            int total = 0;
+            for (int t = 0; t < sh->numThreads; t++)
+                total += sh->localSizes[t];
+            int *tmp = sh->frontier;
+            sh->frontier = sh->nextFrontier;
+            sh->nextFrontier = tmp;
+            sh->frontierSize = total;
+            sh->nextIndex = 0;
+            sh->level++;
+        }
+        pthread_barrier_wait(&sh->barrier);
+    }
+    free(local);
+    return NULL;
+}
+
+// Multi-threaded level-synchronous BFS on CSR graph
+// Fills distance with the same values as bfsShortestPathsCSR
+void parallelBFS(CSRGraph *csr, int start, int *distance, int numThreads)
+{
+    int V = csr->V;
+    if (numThreads < 1)
+        numThreads = 1;
+
+    ParallelBFSShared sh;
+    sh.csr = csr;
+    sh.distance = distance;
+    sh.visited = calloc((V + 63) / 64, sizeof(unsigned long long));
+    sh.frontier = malloc(V * sizeof(int));
+    sh.nextFrontier = malloc(V * sizeof(int));
+    sh.localSizes = malloc(numThreads * sizeof(int));
+    sh.numThreads = numThreads;
+    sh.nextIndex = 0;
+    sh.level = 0;
+    pthread_barrier_init(&sh.barrier, NULL, numThreads);
+
+    for (int i = 0; i < V; i++)
+        distance[i] = -1;
+    distance[start] = 0;
+    sh.visited[start >> 6] |= 1ULL << (start & 63);
+    sh.frontier[0] = start;
+    sh.frontierSize = 1;
+
+    ParallelBFSTask *tasks = malloc(numThreads * sizeof(ParallelBFSTask));
+    for (int t = 0; t < numThreads; t++)
+    {
+        tasks[t].shared = &sh;
+        tasks[t].id = t;
+    }
+    runThreads(parallelBFSWorker, tasks, sizeof(ParallelBFSTask), numThreads);
+
+    pthread_barrier_destroy(&sh.barrier);
+    free(tasks);
+    free(sh.localSizes);
+    free(sh.nextFrontier);
+    free(sh.frontier);
+    free(sh.visited);
+}
+
+// Shortest Path BFS (for unweighted graphs) using all cores
+void shortestPathBFSParallel(CSRGraph *csr, int start)
+{
+    int *distance = malloc(csr->V * sizeof(int));
+    parallelBFS(csr, start, distance, getThreadCount());
+
+    printf("Shortest distances from vertex %d (parallel BFS):\n", start);
+    printDistances(distance, csr->V);
+    free(distance);
+}
+
+// State shared by the threads of a delta-stepping run
+typedef struct DeltaSteppingShared
+{
+    CSRGraph *csr;
+    int *dist;
+    int delta;
+    int numThreads;
+    int heavy; // Relax arcs heavier than delta (else light arcs)
+    int done;
+    int *frontier;
+    int frontierSize;
+    int nextIndex; // Next unclaimed frontier position
+
+    // Per-thread lists of vertices whose distance improved
+    int **updated;
+    int *updatedSize;
+    int *updatedCap;
+
+    // Circular buckets, owned by thread 0 between phases
+    int numBuckets;
+    int **bucket;
+    int *bucketSize;
+    int *bucketCap;
+    int current;      // Index of the bucket being settled
+    int *settled;     // Vertices removed from the current bucket (for the heavy phase)
+    int settledSize;
+    int *inFrontier;  // Phase number in which a vertex last entered the frontier
+    int *inSettled;   // Bucket index + 1 in which a vertex was last settled
+    int phase;
+    pthread_barrier_t barrier;
+} DeltaSteppingShared;
+
+// Work item for one thread of a delta-stepping run
+typedef struct DeltaSteppingTask
+{
+    DeltaSteppingShared *shared;
+    int id;
+} DeltaSteppingTask;
+
+// Atomically lower *slot to value; returns 1 if this call lowered it
+static int atomicMinInt(int *slot, int value)
+{
+    int cur = __atomic_load_n(slot, __ATOMIC_RELAXED);
+    while (value < cur)
+    {
+        if (__atomic_compare_exchange_n(slot, &cur, value, 1, __ATOMIC_RELAXED, __ATOMIC_RELAXED))
+            return 1;
+    }
+    return 0;
+}
+
+static void deltaBucketPush(DeltaSteppingShared *sh, int v)
+{
+    int b = (sh->dist[v] / sh->delta) % sh->numBuckets;
+    if (sh->bucketSize[b] == sh->bucketCap[b])
+    {
+        sh->bucketCap[b] = sh->bucketCap[b] ? 2 * sh->bucketCap[b] : 16;
+        sh->bucket[b] = realloc(sh->bucket[b], sh->bucketCap[b] * sizeof(int));
+    }
+    sh->bucket[b][sh->bucketSize[b]++] = v;
+}
+
+// Move the live entries of the current bucket into the frontier
+// Entries whose distance has since moved to an earlier bucket are dropped
+static void deltaTakeCurrentBucket(DeltaSteppingShared *sh)
+{
+    int b = sh->current % sh->numBuckets;
+    sh->phase++;
+    sh->frontierSize = 0;
+    sh->nextIndex = 0;
+    for (int i = 0; i < sh->bucketSize[b]; i++)
+    {
+        int v = sh->bucket[b][i];
+        if (sh->dist[v] / sh->delta != sh->current || sh->inFrontier[v] == sh->phase)
+            continue;
+        sh->inFrontier[v] = sh->phase;
+        sh->frontier[sh->frontierSize++] = v;
+        if (sh->inSettled[v] != sh->current + 1)
+        {
+            sh->inSettled[v] = sh->current + 1;
+            sh->settled[sh->settledSize++] = v;
+        }
+    }
+    sh->bucketSize[b] = 0;
+}
+
+// Run by thread 0 between phases: file improved vertices into buckets and
+// choose the next phase (light phases until the bucket stays empty, then one heavy phase)
+static void deltaSteppingAdvance(DeltaSteppingShared *sh)
+{
+    for (int t = 0; t < sh->numThreads; t++)
+        for (int i = 0; i < sh->updatedSize[t]; i++)
+            deltaBucketPush(sh, sh->updated[t][i]);
+
+    if (!sh->heavy)
+    {
+        deltaTakeCurrentBucket(sh);
+        if (sh->frontierSize > 0)
+            return;
+        // Bucket settled: relax heavy arcs of everything removed from it
+        sh->heavy = 1;
+        memcpy(sh->frontier, sh->settled, sh->settledSize * sizeof(int));
+        sh->frontierSize = sh->settledSize;
+        sh->settledSize = 0;
+        sh->nextIndex = 0;
+        return;
+    }
+
+    // Find the next bucket with live entries
+    sh->heavy = 0;
+    for (int scanned = 0; scanned < sh->numBuckets; scanned++)
+    {
+        sh->current++;
+        deltaTakeCurrentBucket(sh);
+        if (sh->frontierSize > 0)
+            return;
+    }
+    sh->done = 1;
+}
+
+static void *deltaSteppingWorker(void *arg)
+{
+    DeltaSteppingTask *task = arg;
+    DeltaSteppingShared *sh = task->shared;
+    CSRGraph *csr = sh->csr;
+
+    while (1)
+    {
+        pthread_barrier_wait(&sh->barrier);
+        if (sh->done)
+            break;
+
+        int count = 0;
+        int i;
+        while ((i = __atomic_fetch_add(&sh->nextIndex, PARALLEL_BFS_CHUNK, __ATOMIC_RELAXED)) < sh->frontierSize)
+        {
+            int end = i + PARALLEL_BFS_CHUNK < sh->frontierSize ? i + PARALLEL_BFS_CHUNK : sh->frontierSize;
+            for (; i < end; i++)
+            {
+                int u = sh->frontier[i];
+                int du = __atomic_load_n(&sh->dist[u], __ATOMIC_RELAXED);
+                for (int k = csr->offsets[u]; k < csr->offsets[u + 1]; k++)
+                {
+                    if ((csr->weight[k] > sh->delta) != sh->heavy)
+                        continue;
+                    int v = csr->dest[k];
+                    if (!atomicMinInt(&sh->dist[v], du + csr->weight[k]))
+                        continue;
+                    if (count == sh->updatedCap[task->id])
+                    {
+                        sh->updatedCap[task->id] *= 2;
+                        sh->updated[task->id] = realloc(sh->updated[task->id], sh->updatedCap[task->id] * sizeof(int));
+                    }
+                    sh->updated[task->id][count++] = v;
+                }
+            }
+        }
+        sh->updatedSize[task->id] = count;
+        pthread_barrier_wait(&sh->barrier);
+
+        if (task->id == 0)
+            deltaSteppingAdvance(sh);
+    }
+    return NULL;
+}
+
+// Parallel delta-stepping single-source shortest paths on CSR graph
+// Vertices are settled in buckets of width delta; within a bucket, light arcs
+// (weight <= delta) are relaxed in parallel until the bucket stops changing,
+// then heavy arcs of the settled vertices are relaxed once.
+// delta <= 0 picks maxW / average degree. Fills dist (INT_MAX if unreachable)
+// with the same values as Dijkstra; returns 0 if the graph has a negative weight.
+int deltaSteppingShortestPaths(CSRGraph *csr, int src, int *dist, int delta, int numThreads)
+{
+    int V = csr->V;
+    int minW, maxW;
+    csrWeightRange(csr, &minW, &maxW);
+    if (minW < 0)
+        return 0;
+    if (delta <= 0)
+    {
+        int avgDegree = V > 0 && csr->E > V ? csr->E / V : 1;
+        delta = maxW / avgDegree > 0 ? maxW / avgDegree : 1;
+    }
+    if (numThreads < 1)
+        numThreads = 1;
+
+    DeltaSteppingShared sh;
+    sh.csr = csr;
+    sh.dist = dist;
+    sh.delta = delta;
+    sh.numThreads = numThreads;
+    sh.heavy = 0;
+    sh.done = 0;
+    sh.frontier = malloc(V * sizeof(int));
+    sh.nextIndex = 0;
+    sh.updated = malloc(numThreads * sizeof(int *));
+    sh.updatedSize = calloc(numThreads, sizeof(int));
+    sh.updatedCap = malloc(numThreads * sizeof(int));
+    for (int t = 0; t < numThreads; t++)
+    {
+        sh.updatedCap[t] = 1024;
+        sh.updated[t] = malloc(sh.updatedCap[t] * sizeof(int));
+    }
+    // Pending distances lie within maxW of the current bucket, so this many slots never alias
+    sh.numBuckets = maxW / delta + 2;
+    sh.bucket = calloc(sh.numBuckets, sizeof(int *));
+    sh.bucketSize = calloc(sh.numBuckets, sizeof(int));
+    sh.bucketCap = calloc(sh.numBuckets, sizeof(int));
+    sh.settled = malloc(V * sizeof(int));
+    sh.settledSize = 0;
+    sh.inFrontier = calloc(V, sizeof(int));
+    sh.inSettled = calloc(V, sizeof(int));
+    sh.phase = 0;
+    pthread_barrier_init(&sh.barrier, NULL, numThreads);
+
+    for (int v = 0; v < V; v++)
+        dist[v] = INT_MAX;
+    dist[src] = 0;
+    sh.current = 0;
+    deltaBucketPush(&sh, src);
+    deltaTakeCurrentBucket(&sh);
+
+    DeltaSteppingTask *tasks = malloc(numThreads * sizeof(DeltaSteppingTask));
+    for (int t = 0; t < numThreads; t++)
+    {
+        tasks[t].shared = &sh;
+        tasks[t].id = t;
+    }
+    runThreads(deltaSteppingWorker, tasks, sizeof(DeltaSteppingTask), numThreads);
+
+    pthread_barrier_destroy(&sh.barrier);
+    free(tasks);
+    free(sh.inSettled);
+    free(sh.inFrontier);
+    free(sh.settled);
+    for (int b = 0; b < sh.numBuckets; b++)
+        free(sh.bucket[b]);
+    free(sh.bucketCap);
+    free(sh.bucketSize);
+    free(sh.bucket);
+    for (int t = 0; t < numThreads; t++)
+        free(sh.updated[t]);
+    free(sh.updatedCap);
+    free(sh.updatedSize);
+    free(sh.updated);
+    free(sh.frontier);
+    return 1;
+}
+
+void shortestPathDeltaStepping(CSRGraph *csr, int src, int delta)
+{
+    int *dist = malloc(csr->V * sizeof(int));
+    if (!deltaSteppingShortestPaths(csr, src, dist, delta, getThreadCount()))
+    {
+        printf("Delta-stepping requires non-negative edge weights.\n");
+        free(dist);
+        return;
+    }
+
+    printf("Delta-stepping shortest paths from vertex %d:\n", src);
+    printDistances(dist, csr->V);
+    free(dist);
+}
+
+// Create a workspace for point-to-point queries on graphs with V vertices
+// Labels are versioned by a query stamp, so a query only touches the vertices it reaches
+QueryWorkspace *createQueryWorkspace(int V)
+{
+    QueryWorkspace *ws = malloc(sizeof(QueryWorkspace));
+    ws->V = V;
+    ws->stamp = 0;
+    for (int side = 0; side < 2; side++)
+    {
+        ws->dist[side] = malloc(V * sizeof(int));
+        ws->parent[side] = malloc(V * sizeof(int));
+        ws->seen[side] = calloc(V, sizeof(int));
+        ws->settled[side] = calloc(V, sizeof(int));
+        ws->heap[side] = createDaryHeap(64, DARY_HEAP_DEFAULT_ARITY);
+    }
+    return ws;
+}
+
+void freeQueryWorkspace(QueryWorkspace *ws)
+{
+    for (int side = 0; side < 2; side++)
+    {
+        free(ws->dist[side]);
+        free(ws->parent[side]);
+        free(ws->seen[side]);
+        free(ws->settled[side]);
+        freeDaryHeap(ws->heap[side]);
+    }
+    free(ws);
+}
+
+// Start a new query: invalidate all labels in O(1)
+static void queryWorkspaceReset(QueryWorkspace *ws)
+{
+    if (++ws->stamp == INT_MAX)
+    {
+        for (int side = 0; side < 2; side++)
+            for (int v = 0; v < ws->V; v++)
+                ws->seen[side][v] = ws->settled[side][v] = 0;
+        ws->stamp = 1;
+    }
+    ws->heap[0]->size = 0;
+    ws->heap[1]->size = 0;
+}
+
+// Tentative distance of v on one side of the current query (INT_MAX if unreached)
+static int queryDist(QueryWorkspace *ws, int side, int v)
+{
+    return ws->seen[side][v] == ws->stamp ? ws->dist[side][v] : INT_MAX;
+}
+
+static void querySetLabel(QueryWorkspace *ws, int side, int v, int d, int p)
+{
+    ws->seen[side][v] = ws->stamp;
+    ws->dist[side][v] = d;
+    ws->parent[side][v] = p;
+}
+
+// Write the path s -> meet (forward parents) -> t (backward parents) into path
+// Returns the number of vertices on the path
+static int queryBuildPath(QueryWorkspace *ws, int meet, int *path)
+{
+    int len = 0;
+    for (int v = meet; v != -1; v = ws->parent[0][v])
+        path[len++] = v;
+    for (int i = 0; i < len / 2; i++)
+    {
+        int tmp = path[i];
+        path[i] = path[len - 1 - i];
+        path[len - 1 - i] = tmp;
+    }
+    if (ws->seen[1][meet] == ws->stamp)
+        for (int v = ws->parent[1][meet]; v != -1; v = ws->parent[1][v])
+            path[len++] = v;
+    return len;
+}
+
+// Bidirectional Dijkstra s-t query (non-negative weights)
+// Searches forward from s on csr and backward from t on rev, always expanding the
+// side with the smaller queue key, and stops once the two smallest keys sum to at
+// least the best s-t distance found. path (room for V vertices) and pathLen may be
+// NULL; settledCount, if not NULL, receives the number of vertices settled.
+// ws may be NULL or a workspace reused across queries. Returns INT_MAX if t is unreachable.
+int bidirectionalDijkstra(CSRGraph *csr, CSRGraph *rev, int s, int t, QueryWorkspace *ws,
+                          int *path, int *pathLen, int *settledCount)
+{
+    QueryWorkspace *w = ws ? ws : createQueryWorkspace(csr->V);
+    CSRGraph *g[2] = {csr, rev};
+    queryWorkspaceReset(w);
+
+    querySetLabel(w, 0, s, 0, -1);
+    querySetLabel(w, 1, t, 0, -1);
+    daryHeapPush(w->heap[0], 0, s);
+    daryHeapPush(w->heap[1], 0, t);
+    int best = s == t ? 0 : INT_MAX;
+    int meet = s == t ? s : -1;
+    int settled = 0;
+
+    while (!isEmptyDaryHeap(w->heap[0]) && !isEmptyDaryHeap(w->heap[1]))
+    {
+        int topF = w->heap[0]->items[0].dist;
+        int topB = w->heap[1]->items[0].dist;
+        if (best != INT_MAX && (long long)topF + topB >= best)
+            break;
+
+        int side = topF <= topB ? 0 : 1;
+        HeapEntry top = daryHeapPop(w->heap[side]);
+        int u = top.v;
+        if (top.dist > queryDist(w, side, u) || w->settled[side][u] == w->stamp)
+            continue; // Stale entry
+        w->settled[side][u] = w->stamp;
+        settled++;
+
+        for (int k = g[side]->offsets[u]; k < g[side]->offsets[u + 1]; k++)
+        {
+            int v = g[side]->dest[k];
+            int nd = top.dist + g[side]->weight[k];
+            if (nd < queryDist(w, side, v))
+            {
+                querySetLabel(w, side, v, nd, u);
+                daryHeapPush(w->heap[side], nd, v);
+            }
+            int other = queryDist(w, 1 - side, v);
+            if (other != INT_MAX && (long long)nd + other < best)
+            {
+                best = nd + other;
+                meet = v;
+            }
+        }
+    }
+
+    if (pathLen)
+        *pathLen = 0;
+    if (best != INT_MAX && path && pathLen)
+    {
+        *pathLen = queryBuildPath(w, meet, path);
+    }
+    if (settledCount)
+        *settledCount = settled;
+    if (!ws)
+        freeQueryWorkspace(w);
+    return best;
+}
+
+// A* s-t query on CSR graph with a caller-supplied heuristic
+// heuristic(v, t, context) must never overestimate the distance from v to t;
+// with a consistent heuristic each vertex is settled at most once.
+// Arguments and return value are as for bidirectionalDijkstra.
+int aStarShortestPath(CSRGraph *csr, int s, int t, AStarHeuristic heuristic, void *context,
+                      QueryWorkspace *ws, int *path, int *pathLen, int *settledCount)
+{
+    QueryWorkspace *w = ws ? ws : createQueryWorkspace(csr->V);
+    queryWorkspaceReset(w);
+
+    querySetLabel(w, 0, s, 0, -1);
+    daryHeapPush(w->heap[0], heuristic(s, t, context), s);
+    int settled = 0;
+    int result = INT_MAX;
+
+    while (!isEmptyDaryHeap(w->heap[0]))
+    {
+        HeapEntry top = daryHeapPop(w->heap[0]);
+        int u = top.v;
+        int g = queryDist(w, 0, u);
+        if (top.dist - heuristic(u, t, context) > g)
+            continue; // Stale entry
+        settled++;
+        if (u == t)
+        {
+            result = g;
+            break;
+        }
+
+        for (int k = csr->offsets[u]; k < csr->offsets[u + 1]; k++)
+        {
+            int v = csr->dest[k];
+            int nd = g + csr->weight[k];
+            if (nd < queryDist(w, 0, v))
+            {
+                querySetLabel(w, 0, v, nd, u);
+                daryHeapPush(w->heap[0], nd + heuristic(v, t, context), v);
+            }
+        }
+    }
+
+    if (pathLen)
+        *pathLen = 0;
+    if (result != INT_MAX && path && pathLen)
+        *pathLen = queryBuildPath(w, t, path);
+    if (settledCount)
+        *settledCount = settled;
+    if (!ws)
+        freeQueryWorkspace(w);
+    return result;
+}
+
+// Heuristic that always returns 0 (A* then behaves like Dijkstra with early exit)
+int zeroHeuristic(int v, int target, void *context)
+{
+    (void)v;
+    (void)target;
+    (void)context;
+    return 0;
+}
+
+// Precompute landmark distances for the ALT heuristic
+// Landmarks are picked greedily: each new one is the vertex farthest from the
+// landmarks already chosen (by forward distance), starting from vertex 0
+Landmarks *createLandmarks(CSRGraph *csr, CSRGraph *rev, int count)
+{
+    int V = csr->V;
+    Landmarks *lm = malloc(sizeof(Landmarks));
+    lm->count = count < V ? count : V;
+    lm->vertex = malloc(lm->count * sizeof(int));
+    lm->from = malloc(lm->count * sizeof(int *));
+    lm->to = malloc(lm->count * sizeof(int *));
+
+    int *nearest = malloc(V * sizeof(int)); // Distance to the closest chosen landmark
+    for (int v = 0; v < V; v++)
+        nearest[v] = INT_MAX;
+
+    int next = 0;
+    for (int i = 0; i < lm->count; i++)
+    {
+        lm->vertex[i] = next;
+        lm->from[i] = malloc(V * sizeof(int));
+        lm->to[i] = malloc(V * sizeof(int));
+        dijkstraShortestPathsDary(csr, next, lm->from[i], NULL, DARY_HEAP_DEFAULT_ARITY, NULL);
+        dijkstraShortestPathsDary(rev, next, lm->to[i], NULL, DARY_HEAP_DEFAULT_ARITY, NULL);
+
+        int far = -1;
+        for (int v = 0; v < V; v++)
+        {
+            if (lm->from[i][v] < nearest[v])
+                nearest[v] = lm->from[i][v];
+            if (nearest[v] != INT_MAX && (far == -1 || nearest[v] > nearest[far]))
+                far = v;
+        }
+        next = far >= 0 ? far : (next + 1) % V;
+    }
+    free(nearest);
+    return lm;
+}
+
+void freeLandmarks(Landmarks *lm)
+{
+    for (int i = 0; i < lm->count; i++)
+    {
+        free(lm->from[i]);
+        free(lm->to[i]);
+    }
+    free(lm->from);
+    free(lm->to);
+    free(lm->vertex);
+    free(lm);
+}
+
+// ALT heuristic: triangle inequality bounds through each landmark L
+//   d(v,t) >= d(L,t) - d(L,v)   and   d(v,t) >= d(v,L) - d(t,L)
+int landmarkHeuristic(int v, int target, void *context)
+{
+    Landmarks *lm = context;
+    int best = 0;
+    for (int i = 0; i < lm->count; i++)
+    {
+        int *from = lm->from[i], *to = lm->to[i];
+        if (from[v] != INT_MAX && from[target] != INT_MAX && from[target] - from[v] > best)
+            best = from[target] - from[v];
+        if (to[v] != INT_MAX && to[target] != INT_MAX && to[v] - to[target] > best)
+            best = to[v] - to[target];
+    }
+    return best;
+}
+
+// Print the result of a point-to-point query
+static void printPointToPoint(const char *name, int s, int t, int dist, int *path, int pathLen, int settled, int V)
+{
+    if (dist == INT_MAX)
+    {
+        printf("%s: vertex %d is not reachable from vertex %d\n", name, t, s);
+    }
+    else
+    {
+        printf("%s: distance from %d to %d is %d\n", name, s, t, dist);
+        printVertexOrder("Path", path, pathLen);
+    }
+    printf("Vertices settled: %d (of %d)\n", settled, V);
+}
+
+void shortestPathBidirectional(CSRGraph *csr, CSRGraph *rev, int s, int t)
+{
+    int minW, maxW;
+    csrWeightRange(csr, &minW, &maxW);
+    if (minW < 0)
+    {
+        printf("Bidirectional Dijkstra requires non-negative edge weights.\n");
+        return;
+    }
+    int *path = malloc(csr->V * sizeof(int));
+    int pathLen, settled;
+    int dist = bidirectionalDijkstra(csr, rev, s, t, NULL, path, &pathLen, &settled);
+    printPointToPoint("Bidirectional Dijkstra", s, t, dist, path, pathLen, settled, csr->V);
+    free(path);
+}
+
+void shortestPathAStar(CSRGraph *csr, Landmarks *lm, int s, int t)
+{
+    int minW, maxW;
+    csrWeightRange(csr, &minW, &maxW);
+    if (minW < 0)
+    {
+        printf("A* requires non-negative edge weights.\n");
+        return;
+    }
+    int *path = malloc(csr->V * sizeof(int));
+    int pathLen, settled;
+    int dist = aStarShortestPath(csr, s, t, landmarkHeuristic, lm, NULL, path, &pathLen, &settled);
+    printPointToPoint("A* (landmarks)", s, t, dist, path, pathLen, settled, csr->V);
+    free(path);
+}
+
+// Add arc to -> weight to an overlay list, keeping only the lighter of parallel arcs
+static void chArcAdd(CHArcList *list, int to, int weight)
+{
+    for (int i = 0; i < list->count; i++)
+    {
+        if (list->to[i] == to)
+        {
+            if (weight < list->weight[i])
+                list->weight[i] = weight;
+            return;
+        }
+    }
+    if (list->count == list->capacity)
+    {
+        list->capacity = list->capacity ? 2 * list->capacity : 4;
+        list->to = realloc(list->to, list->capacity * sizeof(int));
+        list->weight = realloc(list->weight, list->capacity * sizeof(int));
+    }
+    list->to[list->count] = to;
+    list->weight[list->count] = weight;
+    list->count++;
+}
+
+static void chArcRemove(CHArcList *list, int to)
+{
+    for (int i = 0; i < list->count; i++)
+    {
+        if (list->to[i] == to)
+        {
+            list->count--;
+            list->to[i] = list->to[list->count];
+            list->weight[i] = list->weight[list->count];
+            return;
+        }
+    }
+}
+
+// Pack overlay lists into a CSR graph
+static CSRGraph *chPackArcs(CHArcList *lists, int V)
+{
+    CSRGraph *csr = malloc(sizeof(CSRGraph));
+    csr->V = V;
+    csr->offsets = malloc((V + 1) * sizeof(int));
+    csr->offsets[0] = 0;
+    for (int v = 0; v < V; v++)
+        csr->offsets[v + 1] = csr->offsets[v] + lists[v].count;
+    csr->E = csr->offsets[V];
+    csr->dest = malloc((csr->E ? csr->E : 1) * sizeof(int));
+    csr->weight = malloc((csr->E ? csr->E : 1) * sizeof(int));
+    for (int v = 0; v < V; v++)
+    {
+        if (lists[v].count == 0)
+            continue;
+        memcpy(csr->dest + csr->offsets[v], lists[v].to, lists[v].count * sizeof(int));
+        memcpy(csr->weight + csr->offsets[v], lists[v].weight, lists[v].count * sizeof(int));
+    }
+    return csr;
+}
+
+// Bounded Dijkstra from src over the remaining overlay graph, never entering skip
+// Stops once all marked targets are settled, past distance limit or after
+// maxSettled settled vertices; distances are left in side 0 of the workspace
+static void chWitnessSearch(CHBuild *b, int src, int skip, int limit, int targets, int maxSettled)
+{
+    QueryWorkspace *w = b->ws;
+    queryWorkspaceReset(w);
+    querySetLabel(w, 0, src, 0, -1);
+    daryHeapPush(w->heap[0], 0, src);
+    int settled = 0;
+
+    while (!isEmptyDaryHeap(w->heap[0]) && settled < maxSettled)
+    {
+        HeapEntry top = daryHeapPop(w->heap[0]);
+        if (top.dist > queryDist(w, 0, top.v))
+            continue; // Stale entry
+        if (top.dist > limit)
+            break;
+        settled++;
+        if (b->mark[top.v] == b->markStamp && --targets == 0)
+            break;
+
+        CHArcList *list = &b->out[top.v];
+        for (int j = 0; j < list->count; j++)
+        {
+            int x = list->to[j];
+            int nd = top.dist + list->weight[j];
+            if (x != skip && nd < queryDist(w, 0, x))
+            {
+                querySetLabel(w, 0, x, nd, top.v);
+                daryHeapPush(w->heap[0], nd, x);
+            }
+        }
+    }
+}
+
+// Count the shortcuts needed to contract v; if add is set, also insert them
+// A shortcut u -> x is needed unless a witness path no longer than u -> v -> x avoids v.
+// Priority estimates use a cheaper search, which can only overcount shortcuts.
+static int chContract(CHBuild *b, int v, int add)
+{
+    CHArcList *in = &b->in[v], *out = &b->out[v];
+    int maxOut = 0;
+    b->markStamp++;
+    for (int j = 0; j < out->count; j++)
+    {
+        b->mark[out->to[j]] = b->markStamp;
+        if (out->weight[j] > maxOut)
+            maxOut = out->weight[j];
+    }
+
+    int shortcuts = 0;
+    for (int i = 0; i < in->count; i++)
+    {
+        int u = in->to[i], wu = in->weight[i];
+        chWitnessSearch(b, u, v, wu + maxOut, out->count,
+                        add ? CH_WITNESS_SETTLE_LIMIT : CH_SIMULATE_SETTLE_LIMIT);
+        for (int j = 0; j < out->count; j++)
+        {
+            int x = out->to[j];
+            int via = wu + out->weight[j];
+            if (x == u || queryDist(b->ws, 0, x) <= via)
+                continue;
+            shortcuts++;
+            if (add)
+            {
+                chArcAdd(&b->out[u], x, via);
+                chArcAdd(&b->in[x], u, via);
+            }
+        }
+    }
+    return shortcuts;
+}
+
+// Contraction order key: edge difference, plus already-contracted neighbours and
+// level so that contraction spreads evenly over the graph
+static int chPriority(CHBuild *b, int v)
+{
+    int edgeDifference = chContract(b, v, 0) - b->in[v].count - b->out[v].count;
+    return CH_PRIORITY_EDGE_WEIGHT * edgeDifference + b->contractedNeighbours[v] + b->level[v];
+}
+
+// Account for the contraction of v at neighbour x and refresh x's priority
+static void chUpdateNeighbour(CHBuild *b, DaryHeap *order, int v, int x)
+{
+    b->contractedNeighbours[x]++;
+    if (b->level[v] + 1 > b->level[x])
+        b->level[x] = b->level[v] + 1;
+    b->key[x] = chPriority(b, x);
+    daryHeapPush(order, b->key[x], x);
+}
+
+// Build a contraction hierarchy from a CSR graph (non-negative weights)
+// Vertices are contracted in priority order, re-evaluating the neighbours of each
+// contracted vertex; afterwards every
+// vertex keeps only arcs to higher-ranked vertices, which form the upward graph
+// (out-arcs) and the reversed downward graph (in-arcs). Returns NULL if the graph
+// has negative weights.
+ContractionHierarchy *buildContractionHierarchyCSR(CSRGraph *csr)
+{
+    int V = csr->V;
+    int minW, maxW;
+    csrWeightRange(csr, &minW, &maxW);
+    if (minW < 0)
+        return NULL;
+
+    CHBuild b;
+    b.out = calloc(V, sizeof(CHArcList));
+    b.in = calloc(V, sizeof(CHArcList));
+    b.contractedNeighbours = calloc(V, sizeof(int));
+    b.level = calloc(V, sizeof(int));
+    b.key = malloc(V * sizeof(int));
+    b.mark = calloc(V, sizeof(int));
+    b.markStamp = 0;
+    b.ws = createQueryWorkspace(V);
+    for (int u = 0; u < V; u++)
+    {
+        for (int k = csr->offsets[u]; k < csr->offsets[u + 1]; k++)
+        {
+            int v = csr->dest[k];
+            if (v == u)
+                continue; // Self-loops never lie on a shortest path
+            chArcAdd(&b.out[u], v, csr->weight[k]);
+            chArcAdd(&b.in[v], u, csr->weight[k]);
+        }
+    }
+
+    ContractionHierarchy *ch = malloc(sizeof(ContractionHierarchy));
+    ch->V = V;
+    ch->rank = malloc(V * sizeof(int));
+    ch->shortcuts = 0;
+
+    DaryHeap *order = createDaryHeap(V ? V : 1, DARY_HEAP_DEFAULT_ARITY);
+    for (int v = 0; v < V; v++)
+    {
+        b.key[v] = chPriority(&b, v);
+        daryHeapPush(order, b.key[v], v);
+    }
+
+    int *neighbours = malloc((V ? V : 1) * sizeof(int));
+    int next = 0;
+    while (!isEmptyDaryHeap(order))
+    {
+        HeapEntry top = daryHeapPop(order);
+        int v = top.v;
+        if (top.dist != b.key[v])
+            continue; // Superseded entry or already contracted
+        b.key[v] = INT_MIN;
+
+        ch->rank[v] = next++;
+        ch->shortcuts += chContract(&b, v, 1);
+        // Detach v from the remaining graph; its own lists now hold only upward arcs
+        for (int j = 0; j < b.out[v].count; j++)
+            chArcRemove(&b.in[b.out[v].to[j]], v);
+        for (int i = 0; i < b.in[v].count; i++)
+            chArcRemove(&b.out[b.in[v].to[i]], v);
+        int count = 0;
+        b.markStamp++;
+        for (int j = 0; j < b.out[v].count; j++)
+        {
+            b.mark[b.out[v].to[j]] = b.markStamp;
+            neighbours[count++] = b.out[v].to[j];
+        }
+        for (int i = 0; i < b.in[v].count; i++)
+            if (b.mark[b.in[v].to[i]] != b.markStamp)
+                neighbours[count++] = b.in[v].to[i];
+        for (int i = 0; i < count; i++)
+            chUpdateNeighbour(&b, order, v, neighbours[i]);
+    }
+
+    ch->up = chPackArcs(b.out, V);
+    ch->down = chPackArcs(b.in, V);
+
+    for (int v = 0; v < V; v++)
+    {
+        free(b.out[v].to);
+        free(b.out[v].weight);
+        free(b.in[v].to);
+        free(b.in[v].weight);
+    }
+    free(b.out);
+    free(b.in);
+    free(b.contractedNeighbours);
+    free(b.level);
+    free(b.key);
+    free(b.mark);
+    free(neighbours);
+    freeQueryWorkspace(b.ws);
+    freeDaryHeap(order);
+    return ch;
+}
+
+ContractionHierarchy *buildContractionHierarchy(Graph *graph)
+{
+    CSRGraph *csr = createCSRFromGraph(graph);
+    ContractionHierarchy *ch = buildContractionHierarchyCSR(csr);
+    freeCSR(csr);
+    return ch;
+}
+
+void freeContractionHierarchy(ContractionHierarchy *ch)
+{
+    if (!ch)
+        return;
+    freeCSR(ch->up);
+    freeCSR(ch->down);
+    free(ch->rank);
+    free(ch);
+}
+
+// Write the hierarchy to a binary file: header, rank, then the upward and
+// downward graphs as V, E, offsets, dest, weight. Returns 0 on I/O error.
+int saveContractionHierarchy(ContractionHierarchy *ch, const char *path)
+{
+    FILE *fp = fopen(path, "wb");
+    if (!fp)
+        return 0;
+    int header[3] = {CH_FILE_MAGIC, CH_FILE_VERSION, ch->V};
+    int ok = fwrite(header, sizeof(int), 3, fp) == 3 &&
+             fwrite(&ch->shortcuts, sizeof(long long), 1, fp) == 1 &&
+             fwrite(ch->rank, sizeof(int), ch->V, fp) == (size_t)ch->V;
+    CSRGraph *parts[2] = {ch->up, ch->down};
+    for (int i = 0; i < 2 && ok; i++)
+    {
+        CSRGraph *g = parts[i];
+        ok = fwrite(&g->E, sizeof(int), 1, fp) == 1 &&
+             fwrite(g->offsets, sizeof(int), g->V + 1, fp) == (size_t)g->V + 1 &&
+             fwrite(g->dest, sizeof(int), g->E, fp) == (size_t)g->E &&
+             fwrite(g->weight, sizeof(int), g->E, fp) == (size_t)g->E;
+    }
+    if (fclose(fp) != 0)
+        ok = 0;
+    return ok;
+}
+
+// Read a hierarchy written by saveContractionHierarchy
+// Returns NULL if the file is missing, truncated or of another format/version
+ContractionHierarchy *loadContractionHierarchy(const char *path)
+{
+    FILE *fp = fopen(path, "rb");
+    if (!fp)
+        return NULL;
+    int header[3];
+    if (fread(header, sizeof(int), 3, fp) != 3 || header[0] != CH_FILE_MAGIC ||
+        header[1] != CH_FILE_VERSION || header[2] < 0)
+    {
+        fclose(fp);
+        return NULL;
+    }
+
+    ContractionHierarchy *ch = calloc(1, sizeof(ContractionHierarchy));
+    ch->V = header[2];
+    ch->rank = malloc((ch->V ? ch->V : 1) * sizeof(int));
+    int ok = fread(&ch->shortcuts, sizeof(long long), 1, fp) == 1 &&
+             fread(ch->rank, sizeof(int), ch->V, fp) == (size_t)ch->V;
+    CSRGraph **parts[2] = {&ch->up, &ch->down};
+    for (int i = 0; i < 2 && ok; i++)
+    {
+        CSRGraph *g = calloc(1, sizeof(CSRGraph));
+        *parts[i] = g;
+        g->V = ch->V;
+        ok = fread(&g->E, sizeof(int), 1, fp) == 1 && g->E >= 0;
+        if (!ok)
+            break;
+        g->offsets = malloc((g->V + 1) * sizeof(int));
+        g->dest = malloc((g->E ? g->E : 1) * sizeof(int));
+        g->weight = malloc((g->E ? g->E : 1) * sizeof(int));
+        ok = fread(g->offsets, sizeof(int), g->V + 1, fp) == (size_t)g->V + 1 &&
+             fread(g->dest, sizeof(int), g->E, fp) == (size_t)g->E &&
+             fread(g->weight, sizeof(int), g->E, fp) == (size_t)g->E &&
+             g->offsets[0] == 0 && g->offsets[g->V] == g->E;
+        for (int v = 0; v < g->V && ok; v++)
+            ok = g->offsets[v] <= g->offsets[v + 1];
+        for (int k = 0; k < g->E && ok; k++)
+            ok = g->dest[k] >= 0 && g->dest[k] < g->V;
+    }
+    fclose(fp);
+    if (!ok)
+    {
+        freeContractionHierarchy(ch);
+        return NULL;
+    }
+    return ch;
+}
+
+// Contraction hierarchy s-t distance query
+// Bidirectional Dijkstra that only climbs: forward over upward arcs from s,
+// backward over downward arcs from t. A side stops once its smallest key reaches
+// the best distance; vertices whose label is beaten through a higher neighbour
+// are stalled (not expanded). ws may be NULL or reused across queries.
+// Returns INT_MAX if t is unreachable.
+int chShortestPath(ContractionHierarchy *ch, int s, int t, QueryWorkspace *ws, int *settledCount)
+{
+    QueryWorkspace *w = ws ? ws : createQueryWorkspace(ch->V);
+    CSRGraph *g[2] = {ch->up, ch->down};
+    queryWorkspaceReset(w);
+
+    querySetLabel(w, 0, s, 0, -1);
+    querySetLabel(w, 1, t, 0, -1);
+    daryHeapPush(w->heap[0], 0, s);
+    daryHeapPush(w->heap[1], 0, t);
+    int best = INT_MAX;
+    int settled = 0;
+    int side = 1;
+
+    while (1)
+    {
+        int live[2];
+        for (int i = 0; i < 2; i++)
+            live[i] = !isEmptyDaryHeap(w->heap[i]) && w->heap[i]->items[0].dist < best;
+        if (!live[0] && !live[1])
+            break;
+        side = live[1 - side] ? 1 - side : side; // Alternate while both sides are live
+
+        HeapEntry top = daryHeapPop(w->heap[side]);
+        int u = top.v;
+        if (top.dist > queryDist(w, side, u) || w->settled[side][u] == w->stamp)
+            continue; // Stale entry
+        w->settled[side][u] = w->stamp;
+        settled++;
+
+        int other = queryDist(w, 1 - side, u);
+        if (other != INT_MAX && (long long)top.dist + other < best)
+            best = top.dist + other;
+
+        // Stall-on-demand: a higher vertex x with d(x) + w(x, u) < d(u) proves d(u) is not final
+        CSRGraph *opp = g[1 - side];
+        int stalled = 0;
+        for (int k = opp->offsets[u]; k < opp->offsets[u + 1] && !stalled; k++)
+        {
+            int dx = queryDist(w, side, opp->dest[k]);
+            stalled = dx != INT_MAX && (long long)dx + opp->weight[k] < top.dist;
+        }
+        if (stalled)
+            continue;
+
+        for (int k = g[side]->offsets[u]; k < g[side]->offsets[u + 1]; k++)
+        {
+            int v = g[side]->dest[k];
+            int nd = top.dist + g[side]->weight[k];
+            if (nd < queryDist(w, side, v))
+            {
+                querySetLabel(w, side, v, nd, u);
+                daryHeapPush(w->heap[side], nd, v);
+            }
+        }
+    }
+
+    if (settledCount)
+        *settledCount = settled;
+    if (!ws)
+        freeQueryWorkspace(w);
+    return best;
+}
+
+void shortestPathContractionHierarchy(ContractionHierarchy *ch, int s, int t)
+{
+    int settled;
+    int dist = chShortestPath(ch, s, t, NULL, &settled);
+    if (dist == INT_MAX)
+        printf("Contraction hierarchy: vertex %d is not reachable from vertex %d\n", t, s);
+    else
+        printf("Contraction hierarchy: distance from %d to %d is %d\n", s, t, dist);
+    printf("Vertices settled: %d (of %d), shortcuts in hierarchy: %lld\n", settled, ch->V, ch->shortcuts);
+}
+
+// State shared by the threads of a batched multi-source Dijkstra run
+typedef struct MultiSourceShared
+{
+    CSRGraph *csr;
+    const int *sources;
+    int count;
+    int *out;             // Row i receives the distances from sources[i]
+    const int *potential; // Johnson potentials to undo when writing rows, or NULL
+    int next;             // Next unclaimed source index
+} MultiSourceShared;
+
+// Work item for one thread of a multi-source run
+typedef struct MultiSourceTask
+{
+    MultiSourceShared *shared;
+} MultiSourceTask;
+
+// Multi-source worker: claims sources one at a time and runs Dijkstra with a
+// heap and distance buffer allocated once per thread, then writes the row
+static void *multiSourceWorker(void *arg)
+{
+    MultiSourceTask *task = arg;
+    MultiSourceShared *sh = task->shared;
+    int V = sh->csr->V;
+    int *dist = malloc(V * sizeof(int));
+    DaryHeap *heap = createDaryHeap(V, DARY_HEAP_DEFAULT_ARITY);
+    int i;
+
+    while ((i = __atomic_fetch_add(&sh->next, 1, __ATOMIC_RELAXED)) < sh->count)
+    {
+        int s = sh->sources[i];
+        dijkstraShortestPathsDary(sh->csr, s, dist, NULL, DARY_HEAP_DEFAULT_ARITY, heap);
+        int *row = sh->out + (size_t)i * V;
+        if (!sh->potential)
+        {
+            memcpy(row, dist, V * sizeof(int));
+            continue;
+        }
+        for (int v = 0; v < V; v++)
+            row[v] = dist[v] == INT_MAX ? INT_MAX : dist[v] - sh->potential[s] + sh->potential[v];
+    }
+
+    freeDaryHeap(heap);
+    free(dist);
+    return NULL;
+}
+
+static void runMultiSource(CSRGraph *csr, const int *sources, int count, int *out, const int *potential,
+                           int numThreads)
+{
+    if (numThreads < 1)
+        numThreads = 1;
+    if (numThreads > count)
+        numThreads = count > 0 ? count : 1;
+
+    MultiSourceShared sh;
+    sh.csr = csr;
+    sh.sources = sources;
+    sh.count = count;
+    sh.out = out;
+    sh.potential = potential;
+    sh.next = 0;
+
+    MultiSourceTask *tasks = malloc(numThreads * sizeof(MultiSourceTask));
+    for (int t = 0; t < numThreads; t++)
+        tasks[t].shared = &sh;
+    runThreads(multiSourceWorker, tasks, sizeof(MultiSourceTask), numThreads);
+    free(tasks);
+}
+
+// Dijkstra from each of sources[0 .. count - 1], run concurrently on numThreads threads
+// out is a count x V row-major matrix; row i receives the distances from sources[i]
+// Returns 0 (and leaves out untouched) if the graph has negative weights
+int multiSourceDijkstra(CSRGraph *csr, const int *sources, int count, int *out, int numThreads)
+{
+    int minW, maxW;
+    csrWeightRange(csr, &minW, &maxW);
+    if (minW < 0)
+        return 0;
+    runMultiSource(csr, sources, count, out, NULL, numThreads);
+    return 1;
+}
+
+// Map a V x V int matrix, backed by the file at path or anonymous memory if path is NULL
+static DistanceMatrix *createDistanceMatrix(int V, const char *path)
+{
+    size_t bytes = (size_t)V * V * sizeof(int);
+    if (bytes == 0)
+        bytes = sizeof(int);
+
+    void *data;
+    if (path)
+    {
+        int fd = open(path, O_RDWR | O_CREAT | O_TRUNC, 0644);
+        if (fd < 0)
+            return NULL;
+        if (ftruncate(fd, bytes) != 0)
+        {
+            close(fd);
+            return NULL;
+        }
+        data = mmap(NULL, bytes, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+        close(fd); // The mapping keeps the file open
+    }
+    else
+    {
+        data = mmap(NULL, bytes, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+    }
+    if (data == MAP_FAILED)
+        return NULL;
+
+    DistanceMatrix *m = malloc(sizeof(DistanceMatrix));
+    m->V = V;
+    m->dist = data;
+    m->bytes = bytes;
+    return m;
+}
+
+// Unmap the matrix; a file-backed matrix keeps its contents on disk
+void freeDistanceMatrix(DistanceMatrix *m)
+{
+    if (!m)
+        return;
+    munmap(m->dist, m->bytes);
+    free(m);
+}
+
+// All-pairs shortest paths with Johnson's algorithm
+// If some weight is negative, Bellman-Ford from a virtual vertex joined to every
+// vertex by 0-weight arcs gives potentials h, and w(u, v) + h(u) - h(v) >= 0 makes
+// the graph safe for Dijkstra. Rows are computed by multiSourceDijkstra's thread
+// pool and written into a V x V matrix mapped from path (or anonymous memory if
+// path is NULL). Entry [u * V + v] is the distance from u to v, INT_MAX if unreachable.
+// Returns NULL on a negative cycle or if the matrix cannot be mapped.
+DistanceMatrix *allPairsShortestPaths(CSRGraph *csr, const char *path, int numThreads)
+{
+    int V = csr->V;
+    int minW, maxW;
+    csrWeightRange(csr, &minW, &maxW);
+
+    int *potential = NULL;
+    CSRGraph reweighted = *csr;
+    if (minW < 0)
+    {
+        Edge *edges = malloc((csr->E + V) * sizeof(Edge));
+        for (int u = 0; u < V; u++)
+            for (int k = csr->offsets[u]; k < csr->offsets[u + 1]; k++)
+                edges[k] = (Edge){u, csr->dest[k], csr->weight[k]};
+        for (int v = 0; v < V; v++)
+            edges[csr->E + v] = (Edge){V, v, 0};
+
+        potential = malloc((V + 1) * sizeof(int));
+        int ok = bellmanFordShortestPathsParallel(V + 1, edges, csr->E + V, V, potential, NULL, numThreads);
+        free(edges);
+        if (!ok)
+        {
+            free(potential);
+            return NULL;
+        }
+
+        reweighted.weight = malloc((csr->E ? csr->E : 1) * sizeof(int));
+        for (int u = 0; u < V; u++)
+            for (int k = csr->offsets[u]; k < csr->offsets[u + 1]; k++)
+                reweighted.weight[k] = csr->weight[k] + potential[u] - potential[csr->dest[k]];
+    }
+
+    DistanceMatrix *m = createDistanceMatrix(V, path);
+    if (m)
+    {
+        int *sources = malloc((V ? V : 1) * sizeof(int));
+        for (int v = 0; v < V; v++)
+            sources[v] = v;
+        runMultiSource(&reweighted, sources, V, m->dist, potential, numThreads);
+        free(sources);
+    }
+
+    if (potential)
+    {
+        free(reweighted.weight);
+        free(potential);
+    }
+    return m;
+}
+
+void printDistanceMatrix(DistanceMatrix *m)
+{
+    printf("\nAll-Pairs Shortest Paths:\n    ");
+    for (int j = 0; j < m->V; j++)
+        printf("%5d", j);
+    printf("\n");
+    for (int i = 0; i < m->V; i++)
+    {
+        printf("%4d", i);
+        for (int j = 0; j < m->V; j++)
+        {
+            int d = m->dist[(size_t)i * m->V + j];
+            if (d == INT_MAX)
+                printf("  INF");
+            else
+                printf("%5d", d);
+        }
+        printf("\n");
+    }
+}
+
+void allPairsShortestPathsJohnson(CSRGraph *csr, const char *path)
+{
+    DistanceMatrix *m = allPairsShortestPaths(csr, path, getThreadCount());
+    if (!m)
+    {
+        printf("Graph contains negative weight cycle, or the output matrix could not be mapped\n");
+        return;
+    }
+    printDistanceMatrix(m);
+    if (path)
+        printf("Matrix written to %s (%d x %d ints)\n", path, m->V, m->V);
+    freeDistanceMatrix(m);
+}
+
+// State shared by the threads of a parallel connected components run
+typedef struct ComponentsShared
+{
+    DSU *dsu;
+    Edge *edges;
+    int E;
+    int *label;
+    int next; // Next unclaimed chunk start (edges, then vertices)
+} ComponentsShared;
+
+// Work item for one thread of a connected components run
+typedef struct ComponentsTask
+{
+    ComponentsShared *shared;
+} ComponentsTask;
+
+// Union the endpoints of every edge, claiming PARALLEL_CC_CHUNK edges at a time
+static void *componentsUnionWorker(void *arg)
+{
+    ComponentsShared *sh = ((ComponentsTask *)arg)->shared;
+    int i;
+    while ((i = __atomic_fetch_add(&sh->next, PARALLEL_CC_CHUNK, __ATOMIC_RELAXED)) < sh->E)
+    {
+        int end = i + PARALLEL_CC_CHUNK < sh->E ? i + PARALLEL_CC_CHUNK : sh->E;
+        for (; i < end; i++)
+            dsuUnionConcurrent(sh->dsu, sh->edges[i].src, sh->edges[i].dest);
+    }
+    return NULL;
+}
+
+// Read off the root of every vertex, claiming PARALLEL_CC_CHUNK vertices at a time
+static void *componentsLabelWorker(void *arg)
+{
+    ComponentsShared *sh = ((ComponentsTask *)arg)->shared;
+    int V = sh->dsu->size;
+    int i;
+    while ((i = __atomic_fetch_add(&sh->next, PARALLEL_CC_CHUNK, __ATOMIC_RELAXED)) < V)
+    {
+        int end = i + PARALLEL_CC_CHUNK < V ? i + PARALLEL_CC_CHUNK : V;
+        for (; i < end; i++)
+            sh->label[i] = dsuFindConcurrent(sh->dsu, i);
+    }
+    return NULL;
+}
+
+// Connected components of the (undirected) edge list on numThreads threads
+// Edges are merged with the lock-free dsuUnionConcurrent, which always links the
+// larger root under the smaller, so every component ends up labelled with its
+// smallest vertex. Fills label (room for V) and returns the number of components.
+int connectedComponentsParallel(int V, Edge edges[], int E, int *label, int numThreads)
+{
+    if (numThreads < 1)
+        numThreads = 1;
+
+    ComponentsShared sh;
+    sh.dsu = createDSU(V);
+    sh.edges = edges;
+    sh.E = E;
+    sh.label = label;
+
+    ComponentsTask *tasks = malloc(numThreads * sizeof(ComponentsTask));
+    for (int t = 0; t < numThreads; t++)
+        tasks[t].shared = &sh;
+    sh.next = 0;
+    runThreads(componentsUnionWorker, tasks, sizeof(ComponentsTask), numThreads);
+    sh.next = 0;
+    runThreads(componentsLabelWorker, tasks, sizeof(ComponentsTask), numThreads);
+
+    int count = 0;
+    for (int v = 0; v < V; v++)
+        count += label[v] == v;
+
+    free(tasks);
+    freeDSU(sh.dsu);
+    return count;
+}
+
+void connectedComponents(int V, Edge edges[], int E)
+{
+    int *label = malloc(V * sizeof(int));
+    int count = connectedComponentsParallel(V, edges, E, label, getThreadCount());
+
+    printf("Connected components: %d\n", count);
+    for (int v = 0; v < V; v++)
+        printf("Vertex %d: component %d\n", v, label[v]);
+    free(label);
+}
+
+// Map a whole file privately; with writable set, writes go to private copies of
+// the pages and never reach the file. Returns NULL if the file is missing or empty.
+static void *mapFile(const char *path, size_t *bytes, int writable)
+{
+    int fd = open(path, O_RDONLY);
+    if (fd < 0)
+        return NULL;
+    off_t size = lseek(fd, 0, SEEK_END);
+    if (size <= 0)
+    {
+        close(fd);
+        return NULL;
+    }
+    void *data = mmap(NULL, size, writable ? PROT_READ | PROT_WRITE : PROT_READ, MAP_PRIVATE, fd, 0);
+    close(fd); // The mapping keeps the file open
+    if (data == MAP_FAILED)
+        return NULL;
+    madvise(data, size, MADV_SEQUENTIAL);
+    *bytes = size;
+    return data;
+}
+
+// Parse the integer starting at *p (after any whitespace) and advance *p past it
+// Returns 0 at the end of the text, on a non-digit or on overflow
+static int parseInt(const char **p, const char *end, int *out)
+{
+    const char *s = *p;
+    while (s < end && (unsigned char)*s <= ' ')
+        s++;
+    int negative = s < end && *s == '-';
+    if (negative || (s < end && *s == '+'))
+        s++;
+    if (s == end || *s < '0' || *s > '9')
+        return 0;
+    long long value = 0;
+    while (s < end && *s >= '0' && *s <= '9')
+    {
+        value = value * 10 + (*s++ - '0');
+        if (value > (long long)INT_MAX + 1)
+            return 0;
+    }
+    if (s < end && (unsigned char)*s > ' ')
+        return 0;
+    if (negative)
+        value = -value;
+    if (value > INT_MAX)
+        return 0;
+    *out = (int)value;
+    *p = s;
+    return 1;
+}
+
+// Read a text edge list: "V E directed" followed by E lines "src dest weight",
+// the same numbers main asks for interactively, in one pass over the mapped file.
+// Returns NULL if the file is missing or malformed or names a vertex outside [0, V).
+EdgeList *loadEdgeListText(const char *path)
+{
+    size_t bytes;
+    const char *text = mapFile(path, &bytes, 0);
+    if (!text)
+        return NULL;
+    const char *p = text, *end = text + bytes;
+
+    int V = 0, E = 0, directed = 0;
+    Edge *edges = NULL;
+    // Every edge takes at least 6 characters, which bounds E before allocating
+    int ok = parseInt(&p, end, &V) && parseInt(&p, end, &E) && parseInt(&p, end, &directed) &&
+             V > 0 && E >= 0 && (directed == 0 || directed == 1) && (size_t)E <= bytes / 6;
+    if (ok)
+        ok = (edges = malloc((E ? E : 1) * sizeof(Edge))) != NULL;
+    for (int i = 0; i < E && ok; i++)
+    {
+        Edge *e = &edges[i];
+        ok = parseInt(&p, end, &e->src) && parseInt(&p, end, &e->dest) && parseInt(&p, end, &e->weight) &&
+             (unsigned)e->src < (unsigned)V && (unsigned)e->dest < (unsigned)V;
+    }
+    // Only whitespace may follow the last edge
+    while (ok && p < end && (unsigned char)*p <= ' ')
+        p++;
+    ok = ok && p == end;
+    munmap((void *)text, bytes);
+    if (!ok)
+    {
+        free(edges);
+        return NULL;
+    }
+
+    EdgeList *list = malloc(sizeof(EdgeList));
+    list->V = V;
+    list->E = E;
+    list->directed = directed;
+    list->edges = edges;
+    list->map = NULL;
+    list->mapBytes = 0;
+    return list;
+}
+
+// Open a binary edge list written by saveEdgeListBinary without copying it:
+// list->edges points into a private mapping of the file, so the records are
+// paged in on first touch and may be reordered in place (e.g. by Kruskal's sort).
+// Returns NULL if the file is missing, truncated, of another format/version or
+// names a vertex outside [0, V).
+EdgeList *loadEdgeListBinary(const char *path)
+{
+    size_t bytes;
+    EdgeFileHeader *h = mapFile(path, &bytes, 1);
+    if (!h)
+        return NULL;
+    int ok = bytes >= sizeof(EdgeFileHeader) && h->magic == EDGE_FILE_MAGIC && h->version == EDGE_FILE_VERSION &&
+             h->V > 0 && h->E >= 0 && (h->directed == 0 || h->directed == 1) &&
+             bytes == sizeof(EdgeFileHeader) + (size_t)h->E * sizeof(Edge);
+    Edge *edges = (Edge *)(h + 1);
+    for (int i = 0; ok && i < h->E; i++)
+        ok = (unsigned)edges[i].src < (unsigned)h->V && (unsigned)edges[i].dest < (unsigned)h->V;
+    if (!ok)
+    {
+        munmap(h, bytes);
+        return NULL;
+    }
+
+    EdgeList *list = malloc(sizeof(EdgeList));
+    list->V = h->V;
+    list->E = h->E;
+    list->directed = h->directed;
+    list->edges = edges;
+    list->map = h;
+    list->mapBytes = bytes;
+    return list;
+}
+
+// Load an edge list in either format, telling them apart by the binary magic
+EdgeList *loadEdgeList(const char *path)
+{
+    FILE *fp = fopen(path, "rb");
+    if (!fp)
+        return NULL;
+    int magic = 0;
+    int isBinary = fread(&magic, sizeof(int), 1, fp) == 1 && magic == EDGE_FILE_MAGIC;
+    fclose(fp);
+    return isBinary ? loadEdgeListBinary(path) : loadEdgeListText(path);
+}
+
+// Write edges in the binary format read by loadEdgeListBinary. Returns 0 on I/O error.
+int saveEdgeListBinary(const char *path, int V, Edge edges[], int E, int directed)
+{
+    FILE *fp = fopen(path, "wb");
+    if (!fp)
+        return 0;
+    EdgeFileHeader h = {EDGE_FILE_MAGIC, EDGE_FILE_VERSION, V, E, directed, 0};
+    int ok = fwrite(&h, sizeof(h), 1, fp) == 1 && fwrite(edges, sizeof(Edge), E, fp) == (size_t)E;
+    if (fclose(fp) != 0)
+        ok = 0;
+    return ok;
+}
+
+void freeEdgeList(EdgeList *list)
+{
+    if (!list)
+        return;
+    if (list->map)
+        munmap(list->map, list->mapBytes);
+    else
+        free(list->edges);
+    free(list);
+}
+
+// Build an adjacency list graph (and matrix if withMatrix) from an edge list
+// The lists equal those of addEdgeList over the edges in order, but all nodes come
+// from one arena block in which each vertex's list is contiguous and ascending
+Graph *createGraphFromEdges(int V, Edge edges[], int E, int directed, int withMatrix)
+{
+    Graph *graph = createGraphWithMatrix(V, withMatrix);
+    // end[v] starts one past the block of v; nodes are placed downwards so the
+    // newest node (the list head) has the lowest address
+    size_t *end = calloc(V + 1, sizeof(size_t));
+    for (int i = 0; i < E; i++)
+    {
+        end[edges[i].src + 1]++;
+        if (!directed)
+            end[edges[i].dest + 1]++;
+    }
+    for (int v = 0; v < V; v++)
+        end[v + 1] += end[v];
+    AdjListNode *nodes = E > 0 ? allocAdjListNodes(graph, end[V]) : NULL;
+    for (int v = 0; v < V; v++)
+        end[v] = end[v + 1];
+
+    for (int i = 0; i < E; i++)
+    {
+        int src = edges[i].src, dest = edges[i].dest, weight = edges[i].weight;
+        AdjListNode *node = &nodes[--end[src]];
+        *node = (AdjListNode){dest, weight, graph->array[src].head};
+        graph->array[src].head = node;
+        if (!directed)
+        {
+            node = &nodes[--end[dest]];
+            *node = (AdjListNode){src, weight, graph->array[dest].head};
+            graph->array[dest].head = node;
+        }
+        addEdgeMatrix(graph, src, dest, weight, directed);
+    }
+    free(end);
+    return graph;
+}
+
+// Byte positions of the snapshot sections: offsets, dest, weight, edges, end of file
+static void snapshotLayout(int V, int arcs, int E, size_t pos[5])
+{
+    size_t a = SNAPSHOT_SECTION_ALIGN, b = SNAPSHOT_EDGES_ALIGN;
+    pos[0] = (sizeof(SnapshotFileHeader) + a - 1) / a * a;
+    pos[1] = (pos[0] + ((size_t)V + 1) * sizeof(int) + a - 1) / a * a;
+    pos[2] = (pos[1] + (size_t)arcs * sizeof(int) + a - 1) / a * a;
+    pos[3] = (pos[2] + (size_t)arcs * sizeof(int) + b - 1) / b * b;
+    pos[4] = pos[3] + (size_t)E * sizeof(Edge);
+}
+
+// Write a CSR graph and the edge list it came from as a snapshot that
+// openGraphSnapshot maps back without parsing. Returns 0 on I/O error.
+int saveGraphSnapshot(const char *path, CSRGraph *csr, Edge edges[], int E, int directed)
+{
+    FILE *fp = fopen(path, "wb");
+    if (!fp)
+        return 0;
+    size_t pos[5];
+    snapshotLayout(csr->V, csr->E, E, pos);
+    SnapshotFileHeader h = {SNAPSHOT_FILE_MAGIC, SNAPSHOT_FILE_VERSION, csr->V, csr->E, E, directed, (long long)pos[4]};
+    // Seeking past the end leaves zero-filled gaps between the sections
+    int ok = fwrite(&h, sizeof(h), 1, fp) == 1 &&
+             fseek(fp, pos[0], SEEK_SET) == 0 &&
+             fwrite(csr->offsets, sizeof(int), csr->V + 1, fp) == (size_t)csr->V + 1 &&
+             fseek(fp, pos[1], SEEK_SET) == 0 &&
+             fwrite(csr->dest, sizeof(int), csr->E, fp) == (size_t)csr->E &&
+             fseek(fp, pos[2], SEEK_SET) == 0 &&
+             fwrite(csr->weight, sizeof(int), csr->E, fp) == (size_t)csr->E &&
+             fseek(fp, pos[3], SEEK_SET) == 0 &&
+             fwrite(edges, sizeof(Edge), E, fp) == (size_t)E &&
+             fflush(fp) == 0 && ftruncate(fileno(fp), pos[4]) == 0; // Covers an empty edge section
+    if (fclose(fp) != 0)
+        ok = 0;
+    return ok;
+}
+
+// Map a snapshot written by saveGraphSnapshot; nothing is read or copied up front,
+// pages are faulted in as BFS/Dijkstra touch them. The header and file size are
+// always checked; verify also scans the arrays for out-of-range offsets and
+// vertices (one pass over the file), which a trusted file can skip.
+// Returns NULL if the file is missing, truncated or of another format/version.
+GraphSnapshot *openGraphSnapshot(const char *path, int verify)
+{
+    int fd = open(path, O_RDONLY);
+    if (fd < 0)
+        return NULL;
+    off_t size = lseek(fd, 0, SEEK_END);
+    if (size < (off_t)sizeof(SnapshotFileHeader))
+    {
+        close(fd);
+        return NULL;
+    }
+    char *data = mmap(NULL, size, PROT_READ, MAP_PRIVATE, fd, 0);
+    close(fd); // The mapping keeps the file open
+    if (data == MAP_FAILED)
+        return NULL;
+
+    SnapshotFileHeader *h = (SnapshotFileHeader *)data;
+    size_t pos[5];
+    int ok = h->magic == SNAPSHOT_FILE_MAGIC && h->version == SNAPSHOT_FILE_VERSION && h->V > 0 &&
+             h->arcs >= 0 && h->E >= 0 && (h->directed == 0 || h->directed == 1);
+    if (ok)
+    {
+        snapshotLayout(h->V, h->arcs, h->E, pos);
+        ok = h->bytes == size && pos[4] == (size_t)size;
+    }
+    int *offsets = (int *)(data + (ok ? pos[0] : 0));
+    ok = ok && offsets[0] == 0 && offsets[h->V] == h->arcs;
+    if (ok && h->E > 0)
+        ok = mprotect(data + pos[3], size - pos[3], PROT_READ | PROT_WRITE) == 0;
+    if (!ok)
+    {
+        munmap(data, size);
+        return NULL;
+    }
+
+    GraphSnapshot *snapshot = malloc(sizeof(GraphSnapshot));
+    snapshot->csr.V = h->V;
+    snapshot->csr.E = h->arcs;
+    snapshot->csr.offsets = offsets;
+    snapshot->csr.dest = (int *)(data + pos[1]);
+    snapshot->csr.weight = (int *)(data + pos[2]);
+    snapshot->edges = (Edge *)(data + pos[3]);
+    snapshot->E = h->E;
+    snapshot->directed = h->directed;
+    snapshot->map = data;
+    snapshot->mapBytes = size;
+
+    if (verify)
+    {
+        CSRGraph *g = &snapshot->csr;
+        for (int v = 0; v < g->V && ok; v++)
+            ok = g->offsets[v] <= g->offsets[v + 1];
+        for (int k = 0; k < g->E && ok; k++)
+            ok = (unsigned)g->dest[k] < (unsigned)g->V;
+        for (int i = 0; i < snapshot->E && ok; i++)
+            ok = (unsigned)snapshot->edges[i].src < (unsigned)g->V && (unsigned)snapshot->edges[i].dest < (unsigned)g->V;
+        if (!ok)
+        {
+            closeGraphSnapshot(snapshot);
+            return NULL;
+        }
+    }
+    return snapshot;
+}
+
+void closeGraphSnapshot(GraphSnapshot *snapshot)
+{
+    if (!snapshot)
+        return;
+    munmap(snapshot->map, snapshot->mapBytes);
+    free(snapshot);
+}
+
+static void initDynamicAdjacency(DynamicAdjacency *adj, int V)
+{
+    adj->arcs = calloc(V, sizeof(DynamicArc *));
+    adj->degree = calloc(V, sizeof(int));
+    adj->capacity = calloc(V, sizeof(int));
+}
+
+static void freeDynamicAdjacency(DynamicAdjacency *adj, int V)
+{
+    for (int v = 0; v < V; v++)
+        free(adj->arcs[v]);
+    free(adj->arcs);
+    free(adj->degree);
+    free(adj->capacity);
+}
+
+// Create a dynamic graph with V vertices and no arcs
+DynamicGraph *createDynamicGraph(int V, int directed)
+{
+    DynamicGraph *g = malloc(sizeof(DynamicGraph));
+    g->V = V;
+    g->directed = directed;
+    initDynamicAdjacency(&g->out, V);
+    if (directed)
+        initDynamicAdjacency(&g->in, V);
+    else
+        g->in = g->out;
+    g->arcCount = 0;
+    g->version = 0;
+    pthread_rwlock_init(&g->lock, NULL);
+    return g;
+}
+
+void freeDynamicGraph(DynamicGraph *g)
+{
+    if (!g)
+        return;
+    freeDynamicAdjacency(&g->out, g->V);
+    if (g->directed)
+        freeDynamicAdjacency(&g->in, g->V);
+    pthread_rwlock_destroy(&g->lock);
+    free(g);
+}
+
+// Append arc u -> v, doubling u's block when it is full
+static void dynamicInsertArc(DynamicAdjacency *adj, int u, int v, int weight)
+{
+    if (adj->degree[u] == adj->capacity[u])
+    {
+        adj->capacity[u] = adj->capacity[u] ? 2 * adj->capacity[u] : DYNAMIC_MIN_BLOCK;
+        adj->arcs[u] = realloc(adj->arcs[u], adj->capacity[u] * sizeof(DynamicArc));
+    }
+    adj->arcs[u][adj->degree[u]++] = (DynamicArc){v, weight};
+}
+
+// Find one arc u -> v of the given weight; NULL if there is none
+static DynamicArc *dynamicFindArc(DynamicAdjacency *adj, int u, int v, int weight)
+{
+    for (int k = 0; k < adj->degree[u]; k++)
+        if (adj->arcs[u][k].dest == v && adj->arcs[u][k].weight == weight)
+            return &adj->arcs[u][k];
+    return NULL;
+}
+
+// Batch operations; a batch is either Edges (insert, delete) or WeightChanges
+enum
+{
+    DYNAMIC_INSERT,
+    DYNAMIC_DELETE,
+    DYNAMIC_REWEIGHT
+};
+
+// Work item for one thread applying a batch
+// Thread id owns the vertices v with (v >> DYNAMIC_OWNER_SHIFT) % numThreads == id
+// and applies, in batch order, exactly the changes to their blocks, so no two
+// threads touch the same block
+typedef struct DynamicBatchTask
+{
+    DynamicGraph *g;
+    Edge *edges;
+    WeightChange *changes;
+    int count;
+    int op;
+    int id;
+    int numThreads;
+    long long applied; // Arcs changed by this thread
+} DynamicBatchTask;
+
+static void *dynamicBatchWorker(void *arg)
+{
+    DynamicBatchTask *t = arg;
+    DynamicGraph *g = t->g;
+    for (int i = 0; i < t->count; i++)
+    {
+        WeightChange c;
+        if (t->op == DYNAMIC_REWEIGHT)
+            c = t->changes[i];
+        else
+            c = (WeightChange){t->edges[i].src, t->edges[i].dest, t->edges[i].weight, t->edges[i].weight};
+
+        // Side 0 is the arc src -> dest in out-block src, side 1 its mirror in
+        // block dest: the in-block of a directed graph, the reverse arc otherwise
+        for (int side = 0; side < 2; side++)
+        {
+            DynamicAdjacency *adj = side ? &g->in : &g->out;
+            int u = side ? c.dest : c.src;
+            int v = side ? c.src : c.dest;
+            if ((u >> DYNAMIC_OWNER_SHIFT) % t->numThreads != t->id)
+                continue;
+            if (t->op == DYNAMIC_INSERT)
+            {
+                dynamicInsertArc(adj, u, v, c.newWeight);
+            }
+            else
+            {
+                DynamicArc *a = dynamicFindArc(adj, u, v, c.oldWeight);
+                if (!a)
+                    continue;
+                if (t->op == DYNAMIC_DELETE)
+                    *a = adj->arcs[u][--adj->degree[u]]; // Move the last arc into the hole
+                else
+                    a->weight = c.newWeight;
+            }
+            if (side == 0 || !g->directed) // A directed graph's mirror is not an arc of its own
+                t->applied++;
+        }
+    }
+    return NULL;
+}
+
+// Apply a batch as one update
+// Returns the number of arcs changed, or -1 (graph untouched) if an entry names a
+// vertex outside [0, V)
+static long long dynamicGraphApply(DynamicGraph *g, Edge edges[], WeightChange changes[], int count, int op,
+                                   int numThreads)
+{
+    for (int i = 0; i < count; i++)
+    {
+        int u = changes ? changes[i].src : edges[i].src;
+        int v = changes ? changes[i].dest : edges[i].dest;
+        if ((unsigned)u >= (unsigned)g->V || (unsigned)v >= (unsigned)g->V)
+            return -1;
+    }
+    if (numThreads < 1 || count < DYNAMIC_PARALLEL_MIN_BATCH)
+        numThreads = 1;
+
+    DynamicBatchTask *tasks = malloc(numThreads * sizeof(DynamicBatchTask));
+    for (int t = 0; t < numThreads; t++)
+        tasks[t] = (DynamicBatchTask){g, edges, changes, count, op, t, numThreads, 0};
+
+    pthread_rwlock_wrlock(&g->lock);
+    runThreads(dynamicBatchWorker, tasks, sizeof(DynamicBatchTask), numThreads);
+    long long applied = 0;
+    for (int t = 0; t < numThreads; t++)
+        applied += tasks[t].applied;
+    if (op == DYNAMIC_INSERT)
+        g->arcCount += applied;
+    else if (op == DYNAMIC_DELETE)
+        g->arcCount -= applied;
+    g->version++;
+    pthread_rwlock_unlock(&g->lock);
+
+    free(tasks);
+    return applied;
+}
+
+// Insert a batch of edges (two arcs each if the graph is undirected)
+// Parallel edges are kept, as with addEdgeList
+long long dynamicGraphInsertEdges(DynamicGraph *g, Edge batch[], int count, int numThreads)
+{
+    return dynamicGraphApply(g, batch, NULL, count, DYNAMIC_INSERT, numThreads);
+}
+
+// Delete a batch of edges; each removes one arc src -> dest with the same weight
+// (and its reverse if undirected). Edges not in the graph are skipped.
+long long dynamicGraphDeleteEdges(DynamicGraph *g, Edge batch[], int count, int numThreads)
+{
+    return dynamicGraphApply(g, batch, NULL, count, DYNAMIC_DELETE, numThreads);
+}
+
+// Change the weights of a batch of arcs; changes whose arc src -> dest with
+// oldWeight is not in the graph are skipped
+long long dynamicGraphUpdateWeights(DynamicGraph *g, WeightChange batch[], int count, int numThreads)
+{
+    return dynamicGraphApply(g, NULL, batch, count, DYNAMIC_REWEIGHT, numThreads);
+}
+
+// Copy the current graph into a CSR graph, for the CSR routines
+CSRGraph *createCSRFromDynamicGraph(DynamicGraph *g)
+{
+    pthread_rwlock_rdlock(&g->lock);
+    CSRGraph *csr = malloc(sizeof(CSRGraph));
+    csr->V = g->V;
+    csr->E = (int)g->arcCount;
+    csr->offsets = malloc((g->V + 1) * sizeof(int));
+    csr->dest = malloc((csr->E ? csr->E : 1) * sizeof(int));
+    csr->weight = malloc((csr->E ? csr->E : 1) * sizeof(int));
+    csr->offsets[0] = 0;
+    for (int u = 0; u < g->V; u++)
+    {
+        int k = csr->offsets[u];
+        for (int i = 0; i < g->out.degree[u]; i++, k++)
+        {
+            csr->dest[k] = g->out.arcs[u][i].dest;
+            csr->weight[k] = g->out.arcs[u][i].weight;
+        }
+        csr->offsets[u + 1] = k;
+    }
+    pthread_rwlock_unlock(&g->lock);
+    return csr;
+}
+
+// BFS shortest paths (see bfsShortestPathsCSR) on the graph between two batches
+// Returns the version (number of batches applied) the search saw
+long long bfsShortestPathsDynamic(DynamicGraph *g, int start, int *dist, int *parent)
+{
+    for (int i = 0; i < g->V; i++)
+    {
+        dist[i] = -1;
+        if (parent)
+            parent[i] = -1;
+    }
+
+    pthread_rwlock_rdlock(&g->lock);
+    long long version = g->version;
+    Queue q;
+    initQueue(&q);
+    dist[start] = 0;
+    enqueue(&q, start);
+    while (!isEmptyQueue(&q))
+    {
+        int u = dequeue(&q);
+        for (int k = 0; k < g->out.degree[u]; k++)
+        {
+            int v = g->out.arcs[u][k].dest;
+            if (dist[v] == -1)
+            {
+                dist[v] = dist[u] + 1;
+                if (parent)
+                    parent[v] = u;
+                enqueue(&q, v);
+            }
+        }
+    }
+    freeQueue(&q);
+    pthread_rwlock_unlock(&g->lock);
+    return version;
+}
+
+// Dijkstra with a lazy d-ary heap (see dijkstraShortestPathsDary) on the graph
+// between two batches. Returns the version the search saw.
+long long dijkstraShortestPathsDynamic(DynamicGraph *g, int src, int *dist, int *parent)
+{
+    for (int v = 0; v < g->V; v++)
+    {
+        dist[v] = INT_MAX;
+        if (parent)
+            parent[v] = -1;
+    }
+    dist[src] = 0;
+
+    pthread_rwlock_rdlock(&g->lock);
+    long long version = g->version;
+    DaryHeap *h = createDaryHeap(g->V, DARY_HEAP_DEFAULT_ARITY);
+    daryHeapPush(h, 0, src);
+    while (!isEmptyDaryHeap(h))
+    {
+        HeapEntry top = daryHeapPop(h);
+        int u = top.v;
+        if (top.dist > dist[u])
+            continue; // Stale entry
+        for (int k = 0; k < g->out.degree[u]; k++)
+        {
+            int v = g->out.arcs[u][k].dest;
+            int nd = dist[u] + g->out.arcs[u][k].weight;
+            if (nd < dist[v])
+            {
+                dist[v] = nd;
+                if (parent)
+                    parent[v] = u;
+                daryHeapPush(h, nd, v);
+            }
+        }
+    }
+    freeDaryHeap(h);
+    pthread_rwlock_unlock(&g->lock);
+    return version;
+}
+
+// Whether some arc u -> v still gives v its distance (dist[u] + w <= dist[v])
+static int dynamicHasTightArc(DynamicGraph *g, int u, int v, int *dist)
+{
+    if (dist[u] == INT_MAX)
+        return 0;
+    for (int k = 0; k < g->out.degree[u]; k++)
+        if (g->out.arcs[u][k].dest == v && dist[u] + g->out.arcs[u][k].weight <= dist[v])
+            return 1;
+    return 0;
+}
+
+// Repair single-source shortest paths after a batch of weight changes, in the
+// style of Ramalingam and Reps. dist/parent must hold the shortest paths before
+// the batch (as filled by dijkstraShortestPathsDynamic) and the batch must already
+// be applied by dynamicGraphUpdateWeights; only the endpoints of the changes are
+// used, the new weights are read from the graph. Weights must be non-negative.
+//  1. A vertex whose tree arc got heavier, with no arc from its parent still tight,
+//     loses its path, and so does its subtree of the shortest path tree: they are
+//     reset to unreachable.
+//  2. Every reset vertex takes the best distance offered by in-neighbours outside
+//     the reset region, and every arc that got lighter is relaxed.
+//  3. Dijkstra from the vertices labelled in step 2 settles everything that changed.
+// Work is limited to the reset region and the vertices whose distance drops.
+// Returns the number of vertices settled in step 3.
+int repairShortestPathsDynamic(DynamicGraph *g, int *dist, int *parent, WeightChange changes[], int count)
+{
+    pthread_rwlock_rdlock(&g->lock);
+    int sides = g->directed ? 1 : 2;
+    int resetCount = 0, resetCapacity = 16;
+    int *reset = malloc(resetCapacity * sizeof(int));
+
+    // Step 1: cut the subtrees below tree arcs that are no longer tight
+    for (int i = 0; i < count; i++)
+    {
+        for (int side = 0; side < sides; side++)
+        {
+            int u = side ? changes[i].dest : changes[i].src;
+            int v = side ? changes[i].src : changes[i].dest;
+            if (parent[v] != u || dynamicHasTightArc(g, u, v, dist))
+                continue;
+            if (resetCount == resetCapacity)
+                reset = realloc(reset, (resetCapacity *= 2) * sizeof(int));
+            reset[resetCount++] = v;
+            dist[v] = INT_MAX;
+            parent[v] = -1;
+        }
+    }
+    for (int r = 0; r < resetCount; r++)
+    {
+        int x = reset[r];
+        for (int k = 0; k < g->out.degree[x]; k++)
+        {
+            int y = g->out.arcs[x][k].dest;
+            if (parent[y] != x)
+                continue;
+            if (resetCount == resetCapacity)
+                reset = realloc(reset, (resetCapacity *= 2) * sizeof(int));
+            reset[resetCount++] = y;
+            dist[y] = INT_MAX;
+            parent[y] = -1;
+        }
+    }
+
+    // Step 2: labels from outside the reset region and over lighter arcs
+    DaryHeap *h = createDaryHeap(resetCount + count, DARY_HEAP_DEFAULT_ARITY);
+    for (int r = 0; r < resetCount; r++)
+    {
+        int y = reset[r];
+        for (int k = 0; k < g->in.degree[y]; k++)
+        {
+            int x = g->in.arcs[y][k].dest;
+            if (dist[x] != INT_MAX && dist[x] + g->in.arcs[y][k].weight < dist[y])
+            {
+                dist[y] = dist[x] + g->in.arcs[y][k].weight;
+                parent[y] = x;
+            }
+        }
+        if (dist[y] != INT_MAX)
+            daryHeapPush(h, dist[y], y);
+    }
+    for (int i = 0; i < count; i++)
+    {
+        for (int side = 0; side < sides; side++)
+        {
+            int u = side ? changes[i].dest : changes[i].src;
+            int v = side ? changes[i].src : changes[i].dest;
+            if (dist[u] == INT_MAX)
+                continue;
+            for (int k = 0; k < g->out.degree[u]; k++)
+            {
+                int nd = dist[u] + g->out.arcs[u][k].weight;
+                if (g->out.arcs[u][k].dest == v && nd < dist[v])
+                {
+                    dist[v] = nd;
+                    parent[v] = u;
+                    daryHeapPush(h, nd, v);
+                }
+            }
+        }
+    }
+
+    // Step 3: Dijkstra over the affected region
+    int settled = 0;
+    while (!isEmptyDaryHeap(h))
+    {
+        HeapEntry top = daryHeapPop(h);
+        int u = top.v;
+        if (top.dist > dist[u])
+            continue; // Stale entry
+        settled++;
+        for (int k = 0; k < g->out.degree[u]; k++)
+        {
+            int v = g->out.arcs[u][k].dest;
+            int nd = dist[u] + g->out.arcs[u][k].weight;
+            if (nd < dist[v])
+            {
+                dist[v] = nd;
+                parent[v] = u;
+                daryHeapPush(h, nd, v);
+            }
+        }
+    }
+
+    freeDaryHeap(h);
+    free(reset);
+    pthread_rwlock_unlock(&g->lock);
+    return settled;
+}
+
+void printDynamicGraph(DynamicGraph *g)
+{
+    pthread_rwlock_rdlock(&g->lock);
+    printf("Dynamic graph: %d vertices, %lld arcs, version %lld\n", g->V, g->arcCount, g->version);
+    for (int v = 0; v < g->V; v++)
+    {
+        printf("Vertex %d:", v);
+        for (int k = 0; k < g->out.degree[v]; k++)
+            printf(" -> %d(w=%d)", g->out.arcs[v][k].dest, g->out.arcs[v][k].weight);
+        printf("\n");
+    }
+    pthread_rwlock_unlock(&g->lock);
+}
+
+void shortestPathBFSDynamic(DynamicGraph *g, int start)
+{
+    int *dist = malloc(g->V * sizeof(int));
+    long long version = bfsShortestPathsDynamic(g, start, dist, NULL);
+
+    printf("Shortest distances from vertex %d (BFS, dynamic graph version %lld):\n", start, version);
+    printDistances(dist, g->V);
+    free(dist);
+}
+
+void shortestPathDijkstraDynamic(DynamicGraph *g, int src)
+{
+    int *dist = malloc(g->V * sizeof(int));
+    long long version = dijkstraShortestPathsDynamic(g, src, dist, NULL);
+
+    printf("Dijkstra's shortest paths from vertex %d (dynamic graph version %lld):\n", src, version);
+    printDistances(dist, g->V);
+    free(dist);
+}
+
+// Shortest paths from src before and after a batch of weight changes, the second
+// repaired incrementally instead of recomputed
+void shortestPathDijkstraIncremental(DynamicGraph *g, int src, WeightChange changes[], int count)
+{
+    int *dist = malloc(g->V * sizeof(int));
+    int *parent = malloc(g->V * sizeof(int));
+    dijkstraShortestPathsDynamic(g, src, dist, parent);
+    printf("Dijkstra's shortest paths from vertex %d before the changes:\n", src);
+    printDistances(dist, g->V);
+
+    long long changed = dynamicGraphUpdateWeights(g, changes, count, getThreadCount());
+    if (changed < 0)
+    {
+        printf("Invalid vertex in batch, nothing changed!\n");
+        free(dist);
+        free(parent);
+        return;
+    }
+    int settled = repairShortestPathsDynamic(g, dist, parent, changes, count);
+    printf("Changed %lld arcs; repaired shortest paths (%d of %d vertices re-settled):\n", changed, settled, g->V);
+    printDistances(dist, g->V);
+    free(dist);
+    free(parent);
+}
+
+// Generate E random edges over V vertices with weights in [1, maxWeight]
+Edge *generateRandomEdges(int V, int E, int maxWeight, unsigned int seed)
+{
+    Edge *edges = malloc(E * sizeof(Edge));
+    srand(seed);
+    for (int i = 0; i < E; i++)
+    {
+        edges[i].src = rand() % V;
+        edges[i].dest = rand() % V;
+        edges[i].weight = 1 + rand() % maxWeight;
+    }
+    return edges;
+}
+
+// Check that edges are sorted by weight
+static int edgesSorted(Edge edges[], int E)
+{
+    for (int i = 1; i < E; i++)
+        if (edges[i - 1].weight > edges[i].weight)
+            return 0;
+    return 1;
+}
+
+// Compare Kruskal's edge sorts: bubble sort vs single and multi-threaded radix sort
+void benchmarkKruskalSort(int E, int maxWeight)
+{
+    Edge *original = generateRandomEdges(E > 1 ? E : 1, E, maxWeight, 12345);
+    Edge *work = malloc(E * sizeof(Edge));
+    int threads = getThreadCount();
+    double t0;
+
+    printf("Kruskal edge sort benchmark: E=%d, weights 1..%d\n", E, maxWeight);
+
+    if (E <= 20000)
+    {
+        memcpy(work, original, E * sizeof(Edge));
+        t0 = wallClockSeconds();
+        bubbleSortEdges(work, E);
+        printf("Bubble sort:            %.4f s (%s)\n", wallClockSeconds() - t0, edgesSorted(work, E) ? "ok" : "NOT SORTED");
+    }
+    else
+    {
+        printf("Bubble sort:            skipped (E > 20000)\n");
+    }
+
+    memcpy(work, original, E * sizeof(Edge));
+    t0 = wallClockSeconds();
+    radixSortEdges(work, E, 1);
+    printf("Radix sort (1 thread):  %.4f s (%s)\n", wallClockSeconds() - t0, edgesSorted(work, E) ? "ok" : "NOT SORTED");
+
+    memcpy(work, original, E * sizeof(Edge));
+    t0 = wallClockSeconds();
+    radixSortEdges(work, E, threads);
+    printf("Radix sort (%d threads): %.4f s (%s)\n", threads, wallClockSeconds() - t0, edgesSorted(work, E) ? "ok" : "NOT SORTED");
+
+    free(work);
+    free(original);
+}
+
+// Compare Kruskal's and Boruvka's MST on a random graph, checking the total weights match
+void benchmarkMST(int V, int E, int maxWeight)
+{
+    Edge *original = generateRandomEdges(V, E, maxWeight, 4242);
+    Edge *work = malloc(E * sizeof(Edge));
+    Edge *result = malloc(V * sizeof(Edge));
+    int threads = getThreadCount();
+    long long kruskalTotal;
+    double t0;
+
+    printf("MST benchmark: V=%d, E=%d, weights 1..%d\n", V, E, maxWeight);
+
+    memcpy(work, original, E * sizeof(Edge));
+    t0 = wallClockSeconds();
+    int e = kruskalMSTEdges(V, work, E, result);
+    double elapsed = wallClockSeconds() - t0;
+    kruskalTotal = mstTotalWeight(result, e);
+    printf("Kruskal:                 %.4f s, %d edges, weight %lld\n", elapsed, e, kruskalTotal);
+
+    for (int t = 1; t <= threads; t *= 2)
+    {
+        memcpy(work, original, E * sizeof(Edge));
+        t0 = wallClockSeconds();
+        e = boruvkaMSTEdges(V, work, E, result, t);
+        elapsed = wallClockSeconds() - t0;
+        long long total = mstTotalWeight(result, e);
+        printf("Boruvka (%2d threads):    %.4f s, %d edges, weight %lld (%s)\n", t, elapsed, e, total,
+               total == kruskalTotal ? "matches" : "MISMATCH");
+    }
+
+    free(result);
+    free(work);
+    free(original);
+}
+
+// Time parallel BFS on 1/2/4/8/16 threads against the sequential CSR BFS
+void benchmarkParallelBFS(int V, int E)
+{
+    Edge *edges = generateRandomEdges(V, E, 1, 777);
+    CSRGraph *csr = createCSRFromEdges(V, edges, E, 0);
+    int *expected = malloc(V * sizeof(int));
+    int *distance = malloc(V * sizeof(int));
+
+    printf("Parallel BFS benchmark: V=%d, E=%d (undirected), %d cores\n", V, E, getThreadCount());
+
+    double t0 = wallClockSeconds();
+    bfsShortestPathsCSR(csr, 0, expected, NULL);
+    double seq = wallClockSeconds() - t0;
+    printf("Sequential BFS:       %.4f s\n", seq);
+
+    for (int t = 1; t <= 16; t *= 2)
+    {
+        t0 = wallClockSeconds();
+        parallelBFS(csr, 0, distance, t);
+        double elapsed = wallClockSeconds() - t0;
+        int same = memcmp(expected, distance, V * sizeof(int)) == 0;
+        printf("Parallel BFS %2d thr:  %.4f s, speedup %.2fx (%s)\n", t, elapsed, seq / elapsed,
+               same ? "matches" : "MISMATCH");
+    }
+
+    free(distance);
+    free(expected);
+    freeCSR(csr);
+    free(edges);
+}
+
+// Compare Dijkstra with the indexed MinHeap against the lazy d-ary heap,
+// the radix heap and Dial's buckets
+void benchmarkDijkstraHeaps(int V, int E, int maxWeight)
+{
+    Edge *edges = generateRandomEdges(V, E, maxWeight, 9001);
+    CSRGraph *csr = createCSRFromEdges(V, edges, E, 1);
+    int *expected = malloc(V * sizeof(int));
+    int *dist = malloc(V * sizeof(int));
+    int arities[] = {2, 4, 8};
+
+    printf("Dijkstra heap benchmark: V=%d, E=%d (directed), weights 1..%d\n", V, E, maxWeight);
+
+    double t0 = wallClockSeconds();
+    dijkstraShortestPathsCSR(csr, 0, expected, NULL);
+    printf("Indexed MinHeap:     %.4f s\n", wallClockSeconds() - t0);
+
+    for (int i = 0; i < 3; i++)
+    {
+        t0 = wallClockSeconds();
+        dijkstraShortestPathsDary(csr, 0, dist, NULL, arities[i], NULL);
+        double elapsed = wallClockSeconds() - t0;
+        printf("Lazy %d-ary heap:     %.4f s (%s)\n", arities[i], elapsed,
+               memcmp(expected, dist, V * sizeof(int)) == 0 ? "matches" : "MISMATCH");
+    }
+
+    t0 = wallClockSeconds();
+    dijkstraShortestPathsRadix(csr, 0, dist, NULL);
+    printf("Radix heap:          %.4f s (%s)\n", wallClockSeconds() - t0,
+           memcmp(expected, dist, V * sizeof(int)) == 0 ? "matches" : "MISMATCH");
+
+    t0 = wallClockSeconds();
+    dijkstraShortestPathsDial(csr, 0, dist, NULL);
+    printf("Dial's buckets:      %.4f s (%s)\n", wallClockSeconds() - t0,
+           memcmp(expected, dist, V * sizeof(int)) == 0 ? "matches" : "MISMATCH");
+
+    free(dist);
+    free(expected);
+    freeCSR(csr);
+    free(edges);
+}
+
+// Time delta-stepping on 1/2/4/8/16 threads against sequential Dijkstra
+void benchmarkDeltaStepping(int V, int E, int maxWeight, int delta)
+{
+    Edge *edges = generateRandomEdges(V, E, maxWeight, 31337);
+    CSRGraph *csr = createCSRFromEdges(V, edges, E, 0);
+    int *expected = malloc(V * sizeof(int));
+    int *dist = malloc(V * sizeof(int));
+
+    printf("Delta-stepping benchmark: V=%d, E=%d (undirected), weights 1..%d, delta=%d, %d cores\n",
+           V, E, maxWeight, delta, getThreadCount());
+
+    double t0 = wallClockSeconds();
+    dijkstraShortestPathsDary(csr, 0, expected, NULL, DARY_HEAP_DEFAULT_ARITY, NULL);
+    double seq = wallClockSeconds() - t0;
+    printf("Dijkstra (4-ary heap):   %.4f s\n", seq);
+
+    for (int t = 1; t <= 16; t *= 2)
+    {
+        t0 = wallClockSeconds();
+        deltaSteppingShortestPaths(csr, 0, dist, delta, t);
+        double elapsed = wallClockSeconds() - t0;
+        printf("Delta-stepping %2d thr:   %.4f s, speedup %.2fx (%s)\n", t, elapsed, seq / elapsed,
+               memcmp(expected, dist, V * sizeof(int)) == 0 ? "matches" : "MISMATCH");
+    }
+
+    free(dist);
+    free(expected);
+    freeCSR(csr);
+    free(edges);
+}
+
+// Answer random s-t queries with full Dijkstra, bidirectional Dijkstra and A*
+// (zero and landmark heuristics), reporting time and vertices settled per query
+void benchmarkPointToPoint(int V, int E, int maxWeight, int queries)
+{
+    Edge *edges = generateRandomEdges(V, E, maxWeight, 4242);
+    CSRGraph *csr = createCSRFromEdges(V, edges, E, 1);
+    CSRGraph *rev = reverseCSR(csr);
+    int *expected = malloc(queries * sizeof(int));
+    int *dist = malloc(V * sizeof(int));
+    int *src = malloc(queries * sizeof(int));
+    int *dst = malloc(queries * sizeof(int));
+    QueryWorkspace *ws = createQueryWorkspace(V);
+    const char *names[] = {"Bidirectional", "A* (zero)", "A* (landmarks)"};
+
+    printf("Point-to-point benchmark: V=%d, E=%d (directed), weights 1..%d, %d queries\n",
+           V, E, maxWeight, queries);
+
+    srand(777);
+    for (int q = 0; q < queries; q++)
+    {
+        src[q] = rand() % V;
+        dst[q] = rand() % V;
+    }
+
+    double t0 = wallClockSeconds();
+    for (int q = 0; q < queries; q++)
+    {
+        dijkstraShortestPathsDary(csr, src[q], dist, NULL, DARY_HEAP_DEFAULT_ARITY, NULL);
+        expected[q] = dist[dst[q]];
+    }
+    printf("Full Dijkstra:       %.6f s/query\n", (wallClockSeconds() - t0) / queries);
+
+    t0 = wallClockSeconds();
+    Landmarks *lm = createLandmarks(csr, rev, ALT_DEFAULT_LANDMARKS);
+    printf("Landmark setup (%d): %.4f s\n", lm->count, wallClockSeconds() - t0);
+
+    for (int m = 0; m < 3; m++)
+    {
+        long long settledTotal = 0;
+        int mismatches = 0;
+        t0 = wallClockSeconds();
+        for (int q = 0; q < queries; q++)
+        {
+            int settled, d;
+            if (m == 0)
+                d = bidirectionalDijkstra(csr, rev, src[q], dst[q], ws, NULL, NULL, &settled);
+            else
+                d = aStarShortestPath(csr, src[q], dst[q], m == 1 ? zeroHeuristic : landmarkHeuristic, lm,
+                                      ws, NULL, NULL, &settled);
+            settledTotal += settled;
+            mismatches += d != expected[q];
+        }
+        printf("%-20s %.6f s/query, %lld settled/query (%s)\n", names[m],
+               (wallClockSeconds() - t0) / queries, settledTotal / queries,
+               mismatches ? "MISMATCH" : "matches");
+    }
+
+    freeLandmarks(lm);
+    freeQueryWorkspace(ws);
+    free(dst);
+    free(src);
+    free(dist);
+    free(expected);
+    freeCSR(rev);
+    freeCSR(csr);
+    free(edges);
+}
+
+// Generate a side x side grid with random weights in [1, maxWeight], a rough
+// stand-in for a road network; the number of edges is stored in *E
+static Edge *generateGridEdges(int side, int maxWeight, unsigned int seed, int *E)
+{
+    Edge *edges = malloc((2 * side * side + 1) * sizeof(Edge));
+    int count = 0;
+    srand(seed);
+    for (int r = 0; r < side; r++)
+    {
+        for (int c = 0; c < side; c++)
+        {
+            int u = r * side + c;
+            if (c + 1 < side)
+                edges[count++] = (Edge){u, u + 1, 1 + rand() % maxWeight};
+            if (r + 1 < side)
+                edges[count++] = (Edge){u, u + side, 1 + rand() % maxWeight};
+        }
+    }
+    *E = count;
+    return edges;
+}
+
+// Time hierarchy preprocessing on a grid and a save/load round trip, then
+// compare query times against full Dijkstra and bidirectional Dijkstra
+void benchmarkContractionHierarchy(int side, int maxWeight, int queries)
+{
+    int V = side * side, E;
+    Edge *edges = generateGridEdges(side, maxWeight, 2718, &E);
+    CSRGraph *csr = createCSRFromEdges(V, edges, E, 0);
+    int *expected = malloc(queries * sizeof(int));
+    int *dist = malloc(V * sizeof(int));
+    int *src = malloc(queries * sizeof(int));
+    int *dst = malloc(queries * sizeof(int));
+    QueryWorkspace *ws = createQueryWorkspace(V);
+    const char *path = "graphs_ch_benchmark.bin";
+
+    printf("Contraction hierarchy benchmark: %dx%d grid, V=%d, E=%d, weights 1..%d, %d queries\n",
+           side, side, V, E, maxWeight, queries);
+
+    double t0 = wallClockSeconds();
+    ContractionHierarchy *built = buildContractionHierarchyCSR(csr);
+    printf("Preprocessing:       %.4f s, %lld shortcuts\n", wallClockSeconds() - t0, built->shortcuts);
+
+    t0 = wallClockSeconds();
+    int saved = saveContractionHierarchy(built, path);
+    ContractionHierarchy *ch = saved ? loadContractionHierarchy(path) : NULL;
+    remove(path);
+    freeContractionHierarchy(built);
+    if (!ch)
+    {
+        printf("Could not save/load the hierarchy.\n");
+        ch = buildContractionHierarchyCSR(csr);
+    }
+    else
+    {
+        printf("Save + load:         %.4f s\n", wallClockSeconds() - t0);
+    }
+
+    srand(1618);
+    for (int q = 0; q < queries; q++)
+    {
+        src[q] = rand() % V;
+        dst[q] = rand() % V;
+    }
+
+    t0 = wallClockSeconds();
+    for (int q = 0; q < queries; q++)
+    {
+        dijkstraShortestPathsDary(csr, src[q], dist, NULL, DARY_HEAP_DEFAULT_ARITY, NULL);
+        expected[q] = dist[dst[q]];
+    }
+    printf("Full Dijkstra:       %.6f s/query\n", (wallClockSeconds() - t0) / queries);
+
+    for (int m = 0; m < 2; m++)
+    {
+        long long settledTotal = 0;
+        int mismatches = 0;
+        t0 = wallClockSeconds();
+        for (int q = 0; q < queries; q++)
+        {
+            int settled;
+            int d = m == 0 ? bidirectionalDijkstra(csr, csr, src[q], dst[q], ws, NULL, NULL, &settled)
+                           : chShortestPath(ch, src[q], dst[q], ws, &settled);
+            settledTotal += settled;
+            mismatches += d != expected[q];
+        }
+        printf("%-20s %.6f s/query, %lld settled/query (%s)\n", m == 0 ? "Bidirectional" : "Contraction hier.",
+               (wallClockSeconds() - t0) / queries, settledTotal / queries, mismatches ? "MISMATCH" : "matches");
+    }
+
+    freeContractionHierarchy(ch);
+    freeQueryWorkspace(ws);
+    free(dst);
+    free(src);
+    free(dist);
+    free(expected);
+    freeCSR(csr);
+    free(edges);
+}
+
+// Compare Bellman-Ford with early exit, SPFA and parallel Bellman-Ford on 1/2/4/8/16
+// threads. Weights are shifted by random vertex potentials, so many are negative
+// but no cycle is.
+void benchmarkBellmanFord(int V, int E, int maxWeight)
+{
+    Edge *edges = generateRandomEdges(V, E, maxWeight, 1729);
+    int *potential = malloc(V * sizeof(int));
+    int *expected = malloc(V * sizeof(int));
+    int *dist = malloc(V * sizeof(int));
+    srand(1730);
+    for (int v = 0; v < V; v++)
+        potential[v] = rand() % (maxWeight + 1);
+    for (int i = 0; i < E; i++)
+        edges[i].weight += potential[edges[i].src] - potential[edges[i].dest];
+
+    printf("Bellman-Ford benchmark: V=%d, E=%d (directed, negative weights, no negative cycle)\n", V, E);
+
+    double t0 = wallClockSeconds();
+    bellmanFordShortestPaths(V, edges, E, 0, expected, NULL);
+    double seq = wallClockSeconds() - t0;
+    printf("Bellman-Ford (early exit): %.4f s\n", seq);
+
+    t0 = wallClockSeconds();
+    spfaShortestPaths(V, edges, E, 0, dist, NULL);
+    printf("SPFA:                      %.4f s (%s)\n", wallClockSeconds() - t0,
+           memcmp(expected, dist, V * sizeof(int)) == 0 ? "matches" : "MISMATCH");
+
+    for (int t = 1; t <= 16; t *= 2)
+    {
+        t0 = wallClockSeconds();
+        bellmanFordShortestPathsParallel(V, edges, E, 0, dist, NULL, t);
+        double elapsed = wallClockSeconds() - t0;
+        printf("Parallel Bellman-Ford %2d thr: %.4f s, speedup %.2fx (%s)\n", t, elapsed, seq / elapsed,
+               memcmp(expected, dist, V * sizeof(int)) == 0 ? "matches" : "MISMATCH");
+    }
+
+    free(dist);
+    free(expected);
+    free(potential);
+    free(edges);
+}
+
+// Run Dijkstra from many sources: one call per source with fresh buffers
+// against the batched thread pool on 1/2/4/8/16 threads
+void benchmarkMultiSource(int V, int E, int maxWeight, int sources)
+{
+    Edge *edges = generateRandomEdges(V, E, maxWeight, 8128);
+    CSRGraph *csr = createCSRFromEdges(V, edges, E, 1);
+    int *src = malloc(sources * sizeof(int));
+    int *expected = malloc((size_t)sources * V * sizeof(int));
+    int *out = malloc((size_t)sources * V * sizeof(int));
+    srand(8129);
+    for (int i = 0; i < sources; i++)
+        src[i] = rand() % V;
+
+    printf("Multi-source benchmark: V=%d, E=%d (directed), weights 1..%d, %d sources\n",
+           V, E, maxWeight, sources);
+
+    double t0 = wallClockSeconds();
+    for (int i = 0; i < sources; i++)
+    {
+        int *dist = malloc(V * sizeof(int));
+        dijkstraShortestPathsCSR(csr, src[i], dist, NULL);
+        memcpy(expected + (size_t)i * V, dist, V * sizeof(int));
+        free(dist);
+    }
+    double seq = wallClockSeconds() - t0;
+    printf("One Dijkstra per source: %.4f s\n", seq);
+
+    for (int t = 1; t <= 16; t *= 2)
+    {
+        t0 = wallClockSeconds();
+        multiSourceDijkstra(csr, src, sources, out, t);
+        double elapsed = wallClockSeconds() - t0;
+        printf("Batched %2d thr:          %.4f s, speedup %.2fx (%s)\n", t, elapsed, seq / elapsed,
+               memcmp(expected, out, (size_t)sources * V * sizeof(int)) == 0 ? "matches" : "MISMATCH");
+    }
+
+    free(out);
+    free(expected);
+    free(src);
+    freeCSR(csr);
+    free(edges);
+}
+
+// Time Tarjan, Kosaraju (including reverseGraph) and condensation on a random
+// directed graph, checking that both algorithms find the same components
+void benchmarkSCC(int V, int E)
+{
+    Edge *edges = generateRandomEdges(V, E, 1, 5040);
+    Graph *graph = createGraphWithMatrix(V, 0);
+    for (int i = 0; i < E; i++)
+        addEdgeList(graph, edges[i].src, edges[i].dest, edges[i].weight, 1);
+    free(edges);
+    int *tarjan = malloc(V * sizeof(int));
+    int *kosaraju = malloc(V * sizeof(int));
+
+    printf("SCC benchmark: V=%d, E=%d (directed)\n", V, E);
+
+    double t0 = wallClockSeconds();
+    int count = sccTarjan(graph, tarjan);
+    printf("Tarjan (iterative):  %.4f s, %d components\n", wallClockSeconds() - t0, count);
+
+    t0 = wallClockSeconds();
+    int countK = sccKosaraju(graph, kosaraju);
+    printf("Kosaraju:            %.4f s, %d components\n", wallClockSeconds() - t0, countK);
+
+    // Same partition iff the id mapping tarjan -> kosaraju is consistent
+    int same = count == countK;
+    int *map = malloc((count ? count : 1) * sizeof(int));
+    for (int c = 0; c < count; c++)
+        map[c] = -1;
+    for (int v = 0; v < V && same; v++)
+    {
+        if (map[tarjan[v]] == -1)
+            map[tarjan[v]] = kosaraju[v];
+        same = map[tarjan[v]] == kosaraju[v];
+    }
+    printf("Partitions %s\n", same ? "match" : "MISMATCH");
+
+    t0 = wallClockSeconds();
+    Graph *dag = condenseGraph(graph, tarjan, count);
+    int *order = malloc((count ? count : 1) * sizeof(int));
+    int ordered = topologicalOrderBFS(dag, order);
+    printf("Condensation + Kahn: %.4f s (%s)\n", wallClockSeconds() - t0,
+           ordered == count ? "acyclic" : "CYCLE");
+
+    free(order);
+    freeGraph(dag);
+    free(map);
+    free(kosaraju);
+    free(tarjan);
+    freeGraph(graph);
+}
+
+// Compare connected components with the sequential DSU (createDSU/dsuFind/dsuUnion)
+// against the lock-free parallel version on 1/2/4/8/16 threads
+void benchmarkConnectedComponents(int V, int E)
+{
+    Edge *edges = generateRandomEdges(V, E, 1, 6174);
+    int *expected = malloc(V * sizeof(int));
+    int *label = malloc(V * sizeof(int));
+
+    printf("Connected components benchmark: V=%d, E=%d, %d cores\n", V, E, getThreadCount());
+
+    double t0 = wallClockSeconds();
+    DSU *dsu = createDSU(V);
+    for (int i = 0; i < E; i++)
+        dsuUnion(dsu, edges[i].src, edges[i].dest);
+    // Label each component by its smallest vertex, as the parallel version does
+    for (int v = 0; v < V; v++)
+        expected[v] = V;
+    for (int v = 0; v < V; v++)
+    {
+        int root = dsuFind(dsu, v);
+        if (v < expected[root])
+            expected[root] = v;
+    }
+    for (int v = 0; v < V; v++)
+        expected[v] = expected[dsuFind(dsu, v)];
+    double seq = wallClockSeconds() - t0;
+    freeDSU(dsu);
+    printf("Sequential DSU:       %.4f s\n", seq);
+
+    for (int t = 1; t <= 16; t *= 2)
+    {
+        t0 = wallClockSeconds();
+        int count = connectedComponentsParallel(V, edges, E, label, t);
+        double elapsed = wallClockSeconds() - t0;
+        printf("Parallel DSU %2d thr:  %.4f s, speedup %.2fx, %d components (%s)\n", t, elapsed, seq / elapsed,
+               count, memcmp(expected, label, V * sizeof(int)) == 0 ? "matches" : "MISMATCH");
+    }
+
+    free(label);
+    free(expected);
+    free(edges);
+}
+
+// The previous DSU layout (separate parent and rank arrays, recursive find with
+// full path compression), kept only as the baseline for benchmarkDSU
+typedef struct RankDSU
+{
+    int *parent;
+    int *rank;
+} RankDSU;
+
+static int rankDSUFind(RankDSU *dsu, int x)
+{
+    if (dsu->parent[x] != x)
+        dsu->parent[x] = rankDSUFind(dsu, dsu->parent[x]);
+    return dsu->parent[x];
+}
+
+static void rankDSUUnion(RankDSU *dsu, int x, int y)
+{
+    int xroot = rankDSUFind(dsu, x);
+    int yroot = rankDSUFind(dsu, y);
+    if (xroot == yroot)
+        return;
+    if (dsu->rank[xroot] < dsu->rank[yroot])
+    {
+        dsu->parent[xroot] = yroot;
+    }
+    else if (dsu->rank[xroot] > dsu->rank[yroot])
+    {
+        dsu->parent[yroot] = xroot;
+    }
+    else
+    {
+        dsu->parent[yroot] = xroot;
+        dsu->rank[xroot]++;
+    }
+}
+
+// DSU microbenchmarks on n elements: E random unions, then a find on every
+// element, for the old parent/rank layout, dsuUnion and dsuUnionBatch.
+// A second round unions i with i + 1 (a chain), the pattern that builds long paths.
+void benchmarkDSU(int n, int E)
+{
+    Edge *random = generateRandomEdges(n, E, 1, 1123);
+    Edge *chain = malloc((n > 1 ? n - 1 : 1) * sizeof(Edge));
+    for (int i = 0; i + 1 < n; i++)
+        chain[i] = (Edge){i, i + 1, 1};
+    Edge *workloads[2] = {random, chain};
+    int sizes[2] = {E, n > 1 ? n - 1 : 0};
+    const char *names[2] = {"random unions", "chain unions"};
+    long long checksum[3];
+
+    printf("DSU benchmark: n=%d (old layout %zu bytes/element, packed %zu bytes/element)\n",
+           n, 2 * sizeof(int), sizeof(int));
+
+    for (int w = 0; w < 2; w++)
+    {
+        Edge *edges = workloads[w];
+        int m = sizes[w];
+        printf("%s (%d):\n", names[w], m);
+
+        RankDSU old;
+        old.parent = malloc(n * sizeof(int));
+        old.rank = calloc(n, sizeof(int));
+        for (int i = 0; i < n; i++)
+            old.parent[i] = i;
+        double t0 = wallClockSeconds();
+        for (int i = 0; i < m; i++)
+            rankDSUUnion(&old, edges[i].src, edges[i].dest);
+        double unite = wallClockSeconds() - t0;
+        t0 = wallClockSeconds();
+        checksum[0] = 0;
+        for (int i = 0; i < n; i++)
+            checksum[0] += rankDSUFind(&old, i) == i;
+        printf("  parent/rank, recursive find: union %.4f s, find %.4f s\n", unite, wallClockSeconds() - t0);
+        free(old.rank);
+        free(old.parent);
+
+        for (int batch = 0; batch < 2; batch++)
+        {
+            DSU *dsu = createDSU(n);
+            t0 = wallClockSeconds();
+            if (batch)
+                dsuUnionBatch(dsu, edges, m, NULL);
+            else
+                for (int i = 0; i < m; i++)
+                    dsuUnion(dsu, edges[i].src, edges[i].dest);
+            unite = wallClockSeconds() - t0;
+            t0 = wallClockSeconds();
+            checksum[1 + batch] = 0;
+            for (int i = 0; i < n; i++)
+                checksum[1 + batch] += dsuFind(dsu, i) == i;
+            printf("  packed, %-21s union %.4f s, find %.4f s (%s)\n", batch ? "dsuUnionBatch:" : "dsuUnion:", unite,
+                   wallClockSeconds() - t0, checksum[1 + batch] == checksum[0] ? "same sets" : "MISMATCH");
+            freeDSU(dsu);
+        }
+    }
+
+    free(chain);
+    free(random);
+}
+
+// Compare loading an edge list with scanf (as main's prompts do), with the mapped
+// text parser and from the binary format, then build the CSR from the loaded edges.
+// The files are written to /tmp and read back while still in the page cache.
+void benchmarkEdgeListLoad(int V, int E)
+{
+    Edge *original = generateRandomEdges(V, E, 1000, 2121);
+    char textPath[64], binaryPath[64];
+    snprintf(textPath, sizeof(textPath), "/tmp/graphs_edges_%d.txt", (int)getpid());
+    snprintf(binaryPath, sizeof(binaryPath), "/tmp/graphs_edges_%d.bin", (int)getpid());
+
+    FILE *fp = fopen(textPath, "w");
+    if (!fp || !saveEdgeListBinary(binaryPath, V, original, E, 1))
+    {
+        printf("Cannot write benchmark files to /tmp\n");
+        if (fp)
+            fclose(fp);
+        free(original);
+        return;
+    }
+    fprintf(fp, "%d %d 1\n", V, E);
+    for (int i = 0; i < E; i++)
+        fprintf(fp, "%d %d %d\n", original[i].src, original[i].dest, original[i].weight);
+    fclose(fp);
+
+    printf("Edge list load benchmark: V=%d, E=%d\n", V, E);
+    const char *paths[3] = {textPath, textPath, binaryPath};
+    const char *names[3] = {"Text, scanf:", "Text, mapped parser:", "Binary, mapped:"};
+    for (int method = 0; method < 3; method++)
+    {
+        double t0 = wallClockSeconds();
+        EdgeList *list = NULL;
+        if (method == 0)
+        {
+            fp = fopen(textPath, "r");
+            list = calloc(1, sizeof(EdgeList));
+            int ok = fscanf(fp, "%d %d %d", &list->V, &list->E, &list->directed) == 3;
+            list->edges = malloc((list->E > 0 ? list->E : 1) * sizeof(Edge));
+            for (int i = 0; i < list->E && ok; i++)
+                ok = fscanf(fp, "%d %d %d", &list->edges[i].src, &list->edges[i].dest, &list->edges[i].weight) == 3;
+            fclose(fp);
+        }
+        else
+        {
+            list = method == 1 ? loadEdgeListText(textPath) : loadEdgeListBinary(binaryPath);
+        }
+        double load = wallClockSeconds() - t0;
+
+        t0 = wallClockSeconds();
+        CSRGraph *csr = list ? createCSRFromEdges(list->V, list->edges, list->E, list->directed) : NULL;
+        double build = wallClockSeconds() - t0;
+
+        int same = list && list->V == V && list->E == E && memcmp(list->edges, original, (size_t)E * sizeof(Edge)) == 0;
+        struct stat st;
+        double megabytes = stat(paths[method], &st) == 0 ? st.st_size / 1e6 : 0;
+        printf("%-22s load %.4f s (%.1f MB/s, %.2f M edges/s), CSR build %.4f s (%s)\n", names[method], load,
+               load > 0 ? megabytes / load : 0, load > 0 ? E / load / 1e6 : 0, build, same ? "ok" : "MISMATCH");
+        freeCSR(csr);
+        freeEdgeList(list);
+    }
+
+    unlink(textPath);
+    unlink(binaryPath);
+    free(original);
+}
+
+// Compare a cold start that rebuilds the CSR from a binary edge list with opening
+// a snapshot (with and without verification), then check BFS and Dijkstra on the
+// mapped snapshot against the rebuilt graph. Files are written to /tmp.
+void benchmarkGraphSnapshot(int V, int E)
+{
+    Edge *original = generateRandomEdges(V, E, 1000, 2222);
+    CSRGraph *built = createCSRFromEdges(V, original, E, 1);
+    char edgePath[64], snapshotPath[64];
+    snprintf(edgePath, sizeof(edgePath), "/tmp/graphs_edges_%d.bin", (int)getpid());
+    snprintf(snapshotPath, sizeof(snapshotPath), "/tmp/graphs_snapshot_%d.gsn", (int)getpid());
+    if (!saveEdgeListBinary(edgePath, V, original, E, 1) || !saveGraphSnapshot(snapshotPath, built, original, E, 1))
+    {
+        printf("Cannot write benchmark files to /tmp\n");
+        unlink(edgePath);
+        freeCSR(built);
+        free(original);
+        return;
+    }
+    freeCSR(built);
+
+    printf("Graph snapshot benchmark: V=%d, E=%d\n", V, E);
+    double t0 = wallClockSeconds();
+    EdgeList *list = loadEdgeListBinary(edgePath);
+    CSRGraph *rebuilt = createCSRFromEdges(V, list->edges, list->E, 1);
+    printf("Edge list + CSR build:      %.4f s\n", wallClockSeconds() - t0);
+
+    t0 = wallClockSeconds();
+    GraphSnapshot *verified = openGraphSnapshot(snapshotPath, 1);
+    printf("Snapshot open (verified):   %.4f s\n", wallClockSeconds() - t0);
+    closeGraphSnapshot(verified);
+
+    t0 = wallClockSeconds();
+    GraphSnapshot *snapshot = openGraphSnapshot(snapshotPath, 0);
+    printf("Snapshot open (unverified): %.4f s\n", wallClockSeconds() - t0);
+
+    int *dist[2], *parent[2];
+    CSRGraph *graphs[2] = {rebuilt, &snapshot->csr};
+    for (int i = 0; i < 2; i++)
+    {
+        dist[i] = malloc(V * sizeof(int));
+        parent[i] = malloc(V * sizeof(int));
+    }
+    const char *names[2] = {"BFS", "Dijkstra"};
+    for (int algo = 0; algo < 2; algo++)
+    {
+        double elapsed[2];
+        for (int i = 0; i < 2; i++)
+        {
+            t0 = wallClockSeconds();
+            if (algo == 0)
+                bfsShortestPathsCSR(graphs[i], 0, dist[i], parent[i]);
+            else
+                dijkstraShortestPathsCSR(graphs[i], 0, dist[i], parent[i]);
+            elapsed[i] = wallClockSeconds() - t0;
+        }
+        printf("%-8s rebuilt %.4f s, snapshot %.4f s (%s)\n", names[algo], elapsed[0], elapsed[1],
+               memcmp(dist[0], dist[1], V * sizeof(int)) == 0 ? "same distances" : "MISMATCH");
+    }
+    printf("Edge array: %s\n",
+           memcmp(snapshot->edges, original, (size_t)E * sizeof(Edge)) == 0 ? "same as written" : "MISMATCH");
+
+    for (int i = 0; i < 2; i++)
+    {
+        free(dist[i]);
+        free(parent[i]);
+    }
+    closeGraphSnapshot(snapshot);
+    freeCSR(rebuilt);
+    freeEdgeList(list);
+    unlink(edgePath);
+    unlink(snapshotPath);
+    free(original);
+}
+
+// Sum of all arc weights reached by walking the adjacency lists
+static long long adjListWeightSum(AdjList *array, int V)
+{
+    long long sum = 0;
+    for (int v = 0; v < V; v++)
+        for (AdjListNode *p = array[v].head; p; p = p->next)
+            sum += p->weight;
+    return sum;
+}
+
+// Time building, walking and freeing an undirected graph's adjacency lists in the
+// node arena, filled edge by edge through addEdgeList and in bulk by
+// createGraphFromEdges, against one malloc per node (the old allocator);
+// reverseGraph is timed on the arena graph
+void benchmarkGraphBuild(int V, int E)
+{
+    Edge *edges = generateRandomEdges(V, E, 1000, 2323);
+    long long expected = 0;
+    for (int i = 0; i < E; i++)
+        expected += 2LL * edges[i].weight;
+    printf("Graph build benchmark: V=%d, E=%d (%zu bytes/node)\n", V, E, sizeof(AdjListNode));
+
+    double t0, build, walk;
+    for (int bulk = 0; bulk < 2; bulk++)
+    {
+        t0 = wallClockSeconds();
+        Graph *graph;
+        if (bulk)
+        {
+            graph = createGraphFromEdges(V, edges, E, 0, 0);
+        }
+        else
+        {
+            graph = createGraphWithMatrix(V, 0);
+            for (int i = 0; i < E; i++)
+                addEdgeList(graph, edges[i].src, edges[i].dest, edges[i].weight, 0);
+        }
+        build = wallClockSeconds() - t0;
+        t0 = wallClockSeconds();
+        long long sum = adjListWeightSum(graph->array, V);
+        walk = wallClockSeconds() - t0;
+
+        double reverse = 0;
+        if (!bulk)
+        {
+            t0 = wallClockSeconds();
+            Graph *rev = reverseGraph(graph);
+            reverse = wallClockSeconds() - t0;
+            freeGraph(rev);
+        }
+        t0 = wallClockSeconds();
+        freeGraph(graph);
+        printf("%-19s build %.4f s, walk %.4f s, free %.4f s (%s)", bulk ? "arena, bulk:" : "arena, addEdgeList:",
+               build, walk, wallClockSeconds() - t0, sum == expected ? "ok" : "MISMATCH");
+        if (!bulk)
+            printf(", reverseGraph %.4f s", reverse);
+        printf("\n");
+    }
+
+    // Baseline last: its millions of freed chunks would slow the arena's mallocs
+    t0 = wallClockSeconds();
+    AdjList *array = calloc(V, sizeof(AdjList));
+    for (int i = 0; i < E; i++)
+    {
+        int ends[2] = {edges[i].src, edges[i].dest};
+        for (int k = 0; k < 2; k++)
         {
-            int u = edges[j].src;
-            int v = edges[j].dest;
-            int weight = edges[j].weight;
-            if (dist[u] != INT_MAX && dist[u] + weight < dist[v])
-                dist[v] = dist[u] + weight;
+            AdjListNode *node = malloc(sizeof(AdjListNode));
+            *node = (AdjListNode){ends[1 - k], edges[i].weight, array[ends[k]].head};
+            array[ends[k]].head = node;
         }
     }
-
-    // Check for negative-weight cycles
-    for (int j = 0; j < E; j++)
+    build = wallClockSeconds() - t0;
+    t0 = wallClockSeconds();
+    long long sum = adjListWeightSum(array, V);
+    walk = wallClockSeconds() - t0;
+    t0 = wallClockSeconds();
+    for (int v = 0; v < V; v++)
     {
-        int u = edges[j].src;
-        int v = edges[j].dest;
-        int weight = edges[j].weight;
-        if (dist[u] != INT_MAX && dist[u] + weight < dist[v])
+        AdjListNode *p = array[v].head;
+        while (p)
         {
-            printf("Graph contains negative weight cycle\n");
-            return;
+            AdjListNode *next = p->next;
+            free(p);
+            p = next;
         }
     }
-
-    printf("Bellman-Ford shortest paths from vertex %d:\n", src);
-    for (int i = 0; i < V; i++)
-        printf("Vertex %d: %d\n", i, dist[i]);
+    free(array);
+    printf("malloc per node:    build %.4f s, walk %.4f s, free %.4f s (%s)\n", build, walk,
+           wallClockSeconds() - t0, sum == expected ? "ok" : "MISMATCH");
+    free(edges);
 }
 
-// Prim's algorithm
-void primMST(Graph *graph)
+// Insert E random directed edges into a dynamic graph in batches, then delete the
+// first half again, checking Dijkstra on the dynamic graph against a CSR graph
+// rebuilt from the edges present; a rebuild is the cost every batch had before
+void benchmarkDynamicGraph(int V, int E, int batchSize)
 {
-    int V = graph->V;
-    int parent[V];
-    int key[V];
-    int inMST[V];
-    for (int i = 0; i < V; i++)
-    {
-        key[i] = INT_MAX;
-        inMST[i] = 0;
-    }
-
-    key[0] = 0;
-    parent[0] = -1;
+    Edge *edges = generateRandomEdges(V, E, 1000, 2424);
+    int threads = getThreadCount();
+    int *dist = malloc(V * sizeof(int));
+    int *expected = malloc(V * sizeof(int));
+    DynamicGraph *g = createDynamicGraph(V, 1);
+    printf("Dynamic graph benchmark: V=%d, E=%d, batches of %d, %d threads\n", V, E, batchSize, threads);
 
-    for (int count = 0; count < V - 1; count++)
+    for (int phase = 0; phase < 2; phase++)
     {
-        // Find the minimum key vertex not yet included in MST
-        int min = INT_MAX, u;
-        for (int v = 0; v < V; v++)
-            if (!inMST[v] && key[v] < min)
-            {
-                min = key[v];
-                u = v;
-            }
-
-        inMST[u] = 1;
-
-        // Update key and parent index of adjacent vertices
-        AdjListNode *pCrawl = graph->array[u].head;
-        while (pCrawl)
+        // Phase 0 inserts all edges, phase 1 deletes edges[0 .. E/2)
+        int count = phase ? E / 2 : E;
+        long long changed = 0;
+        double t0 = wallClockSeconds();
+        for (int i = 0; i < count; i += batchSize)
         {
-            int v = pCrawl->dest;
-            if (!inMST[v] && pCrawl->weight < key[v])
-            {
-                key[v] = pCrawl->weight;
-                parent[v] = u;
-            }
-            pCrawl = pCrawl->next;
+            int n = count - i < batchSize ? count - i : batchSize;
+            changed += phase ? dynamicGraphDeleteEdges(g, edges + i, n, threads)
+                             : dynamicGraphInsertEdges(g, edges + i, n, threads);
         }
+        double elapsed = wallClockSeconds() - t0;
+
+        int first = phase ? E / 2 : 0;
+        t0 = wallClockSeconds();
+        CSRGraph *csr = createCSRFromEdges(V, edges + first, E - first, 1);
+        double rebuild = wallClockSeconds() - t0;
+        dijkstraShortestPathsDary(csr, 0, expected, NULL, DARY_HEAP_DEFAULT_ARITY, NULL);
+        t0 = wallClockSeconds();
+        long long version = dijkstraShortestPathsDynamic(g, 0, dist, NULL);
+        double query = wallClockSeconds() - t0;
+
+        int batches = (count + batchSize - 1) / batchSize;
+        printf("%s %lld arcs in %d batches: %.4f s (%.2f M edges/s); rebuilding a CSR after each: %.4f s\n",
+               phase ? "Delete" : "Insert", changed, batches, elapsed, elapsed > 0 ? count / elapsed / 1e6 : 0,
+               batches * rebuild);
+        printf("  Dijkstra at version %lld: %.4f s (%s)\n", version, query,
+               memcmp(dist, expected, V * sizeof(int)) == 0 ? "matches rebuilt CSR" : "MISMATCH");
+        freeCSR(csr);
     }
 
-    printf("Prim's MST:\n");
-    for (int i = 1; i < V; i++)
-        printf("%d - %d (w=%d)\n", parent[i], i, graph->adjMatrix[parent[i]][i]);
+    freeDynamicGraph(g);
+    free(expected);
+    free(dist);
+    free(edges);
 }
 
-// Kruskal's algorithm
-void kruskalMST(Graph *graph, Edge edges[], int E)
+// Apply rounds of random weight changes to a directed graph and compare repairing
+// the shortest paths with repairShortestPathsDynamic against rerunning Dijkstra
+void benchmarkIncrementalSSSP(int V, int E, int changes)
 {
-    int V = graph->V;
-    // Sort edges based on weight using Bubble Sort (for simplicity)
-    for (int i = 0; i < E - 1; i++)
-    {
-        for (int j = 0; j < E - i - 1; j++)
-        {
-            if (edges[j].weight > edges[j + 1].weight)
-            {
-                Edge temp = edges[j];
-                edges[j] = edges[j + 1];
-                edges[j + 1] = temp;
-            }
-        }
-    }
+    const int rounds = 10;
+    Edge *edges = generateRandomEdges(V, E, 1000, 2525);
+    DynamicGraph *g = createDynamicGraph(V, 1);
+    dynamicGraphInsertEdges(g, edges, E, getThreadCount());
+    int *dist = malloc(V * sizeof(int));
+    int *parent = malloc(V * sizeof(int));
+    int *expected = malloc(V * sizeof(int));
+    WeightChange *batch = malloc((changes > 0 ? changes : 1) * sizeof(WeightChange));
+    dijkstraShortestPathsDynamic(g, 0, dist, parent);
 
-    // Initialize DSU
-    DSU *dsu = createDSU(V);
-
-    Edge result[V];
-    int e = 0;
-    int i = 0;
-    while (e < V - 1 && i < E)
+    printf("Incremental SSSP benchmark: V=%d, E=%d, %d weight changes per round, %d rounds\n", V, E, changes, rounds);
+    srand(2626);
+    double repairTime = 0, fullTime = 0;
+    long long settled = 0;
+    int mismatches = 0;
+    for (int r = 0; r < rounds; r++)
     {
-        Edge next_edge = edges[i++];
-        int x = dsuFind(dsu, next_edge.src);
-        int y = dsuFind(dsu, next_edge.dest);
-
-        if (x != y)
+        // Half the changes make an arc heavier, half lighter
+        for (int j = 0; j < changes && E > 0; j++)
         {
-            result[e++] = next_edge;
-            dsuUnion(dsu, x, y);
+            Edge *e = &edges[rand() % E];
+            int w = j % 2 ? e->weight + 1 + rand() % 1000 : e->weight / 2;
+            batch[j] = (WeightChange){e->src, e->dest, e->weight, w};
+            e->weight = w;
         }
-    }
+        dynamicGraphUpdateWeights(g, batch, changes, getThreadCount());
 
-    printf("Kruskal's MST:\n");
-    for (int i = 0; i < e; i++)
-        printf("%d - %d (w=%d)\n", result[i].src, result[i].dest, result[i].weight);
+        double t0 = wallClockSeconds();
+        settled += repairShortestPathsDynamic(g, dist, parent, batch, changes);
+        repairTime += wallClockSeconds() - t0;
+        t0 = wallClockSeconds();
+        dijkstraShortestPathsDynamic(g, 0, expected, NULL);
+        fullTime += wallClockSeconds() - t0;
+        mismatches += memcmp(dist, expected, V * sizeof(int)) != 0;
+    }
+    printf("Repair:        %.6f s/round, %lld vertices re-settled/round (%s)\n", repairTime / rounds,
+           settled / rounds, mismatches ? "MISMATCH" : "matches Dijkstra");
+    printf("Full Dijkstra: %.6f s/round, up to %d vertices settled\n", fullTime / rounds, V);
 
-    // Free DSU memory
-    free(dsu->parent);
-    free(dsu->rank);
-    free(dsu);
+    free(batch);
+    free(expected);
+    free(parent);
+    free(dist);
+    freeDynamicGraph(g);
+    free(edges);
 }
 
 // Main function with a menu to demonstrate functionalities
-int main()
+// Usage: graphs [file]
+// With a file (graph snapshot, or text or binary edge list, see loadEdgeList) the
+// graph is loaded from it; otherwise it is read from the prompts below.
+int main(int argc, char *argv[])
 {
     int V, E, directed;
-    printf("Enter number of vertices: ");
-    scanf("%d", &V);
-    printf("Enter number of edges: ");
-    scanf("%d", &E);
-    printf("Is the graph directed? (1 for Yes, 0 for No): ");
-    scanf("%d", &directed);
-
-    Graph *graph = createGraph(V);
-    Edge edges[E];
-    printf("Enter edges in format (src dest weight):\n");
-    for (int i = 0; i < E; i++)
+    Edge *edges;
+    GraphSnapshot *snapshot = NULL;
+    if (argc > 1)
     {
-        int src, dest, weight;
-        scanf("%d %d %d", &src, &dest, &weight);
-        addEdgeList(graph, src, dest, weight, directed);
-        addEdgeMatrix(graph, src, dest, weight, directed);
-        edges[i].src = src;
-        edges[i].dest = dest;
-        edges[i].weight = weight;
+        double t0 = wallClockSeconds();
+        snapshot = openGraphSnapshot(argv[1], 1);
+        EdgeList *input = snapshot ? NULL : loadEdgeList(argv[1]);
+        if (!snapshot && !input)
+        {
+            fprintf(stderr, "Cannot load a graph from %s\n", argv[1]);
+            return 1;
+        }
+        // Both stay alive (and mapped) for the whole run
+        V = snapshot ? snapshot->csr.V : input->V;
+        E = snapshot ? snapshot->E : input->E;
+        directed = snapshot ? snapshot->directed : input->directed;
+        edges = snapshot ? snapshot->edges : input->edges;
+        printf("Loaded %s: V=%d, E=%d, %s (%.4f s)\n", argv[1], V, E, directed ? "directed" : "undirected",
+               wallClockSeconds() - t0);
+    }
+    else
+    {
+        printf("Enter number of vertices: ");
+        scanf("%d", &V);
+        printf("Enter number of edges: ");
+        scanf("%d", &E);
+        printf("Is the graph directed? (1 for Yes, 0 for No): ");
+        scanf("%d", &directed);
+
+        // On the heap: a stack array overflows for large E
+        edges = malloc((E > 0 ? E : 1) * sizeof(Edge));
+        printf("Enter edges in format (src dest weight):\n");
+        for (int i = 0; i < E; i++)
+            scanf("%d %d %d", &edges[i].src, &edges[i].dest, &edges[i].weight);
     }
 
+    // Skip the dense matrix for large graphs so memory scales with E
+    // From a snapshot the lists are built on first use, see the menu loop
+    Graph *graph = snapshot ? NULL : createGraphFromEdges(V, edges, E, directed, V <= MATRIX_MAX_VERTICES);
+
     // Initialize DSU for independent usage
     DSU *dsu = createDSU(V);
 
+    // Build CSR form of the graph for the cache-friendly routines
+    // (same arc order as createCSRFromGraph, without walking the lists);
+    // a snapshot's CSR is used in place
+    CSRGraph *csr = snapshot ? &snapshot->csr : createCSRFromEdges(V, edges, E, directed);
+    CSRGraph *csrRev = NULL; // Reversed CSR, built on first use
+    Landmarks *landmarks = NULL; // ALT landmarks, built on first use
+    ContractionHierarchy *hierarchy = NULL; // Built on first use or loaded from file
+    DynamicGraph *dynamic = NULL;           // Built from the edges on first use
+
     int choice, start;
     while (1)
     {
@@ -804,10 +6504,25 @@ int main()
         printf("12. Prim's MST\n");
         printf("13. Kruskal's MST\n");
         printf("14. DSU Operations Menu\n");
-        printf("15. Exit\n");
+        printf("15. CSR Operations Menu\n");
+        printf("16. Benchmarks Menu\n");
+        printf("17. Boruvka's MST (Parallel)\n");
+        printf("18. Shortest Path SPFA (Queue-Based Bellman-Ford)\n");
+        printf("19. Shortest Path Bellman-Ford (Parallel)\n");
+        printf("20. Strongly Connected Components\n");
+        printf("21. Connected Components (Parallel)\n");
+        printf("22. Save Graph as Binary Edge List\n");
+        printf("23. Save Graph Snapshot\n");
+        printf("24. Dynamic Graph Menu\n");
+        printf("25. Exit\n");
         printf("Enter your choice: ");
         scanf("%d", &choice);
 
+        // Items working on the adjacency lists; after a snapshot start the lists
+        // are only built once one of them is chosen
+        if (!graph && ((choice >= 1 && choice <= 13) || choice == 17 || choice == 20))
+            graph = createGraphFromEdges(V, edges, E, directed, V <= MATRIX_MAX_VERTICES);
+
         switch (choice)
         {
         case 1:
@@ -831,8 +6546,7 @@ int main()
             Graph *rev = reverseGraph(graph);
             printf("Reversed Graph Adjacency List:\n");
             printAdjList(rev);
-            // Free reversed graph if necessary
-            // For simplicity, not freeing memory here
+            freeGraph(rev);
             break;
         }
         case 6:
@@ -845,8 +6559,7 @@ int main()
             Graph *dir = convertUndirectedToDirected(graph);
             printf("Directed Graph Adjacency List:\n");
             printAdjList(dir);
-            // Free directed graph if necessary
-            // For simplicity, not freeing memory here
+            freeGraph(dir);
             break;
         }
         case 7:
@@ -933,6 +6646,512 @@ int main()
             break;
         }
         case 15:
+        {
+            // CSR Operations Menu
+            int csr_choice, arity, queueType, delta, target, mode;
+            char fileName[256];
+            while (1)
+            {
+                printf("\nCSR Operations Menu:\n");
+                printf("1. Print CSR Graph\n");
+                printf("2. BFS Traversal (CSR)\n");
+                printf("3. DFS Traversal (CSR)\n");
+                printf("4. Topological Sort (DFS, CSR)\n");
+                printf("5. Topological Sort (BFS/Kahn's, CSR)\n");
+                printf("6. Shortest Path BFS (CSR)\n");
+                printf("7. Shortest Path Dijkstra (CSR)\n");
+                printf("8. Prim's MST (CSR)\n");
+                printf("9. Direction-Optimizing BFS (CSR)\n");
+                printf("10. Shortest Path BFS (Parallel, CSR)\n");
+                printf("11. Shortest Path Dijkstra (d-ary Heap, CSR)\n");
+                printf("12. Shortest Path Dijkstra (Choose Queue, CSR)\n");
+                printf("13. Shortest Path Delta-Stepping (Parallel, CSR)\n");
+                printf("14. Point-to-Point Bidirectional Dijkstra (CSR)\n");
+                printf("15. Point-to-Point A* (Landmark Heuristic, CSR)\n");
+                printf("16. Point-to-Point Contraction Hierarchy Query (CSR)\n");
+                printf("17. Save/Load Contraction Hierarchy\n");
+                printf("18. All-Pairs Shortest Paths (Johnson, Parallel)\n");
+                printf("19. Return to Main Menu\n");
+                printf("Enter your CSR choice: ");
+                scanf("%d", &csr_choice);
+
+                switch (csr_choice)
+                {
+                case 1:
+                    printCSR(csr);
+                    break;
+                case 2:
+                    printf("Enter starting vertex for BFS: ");
+                    scanf("%d", &start);
+                    BFS_CSR(csr, start);
+                    break;
+                case 3:
+                    printf("Enter starting vertex for DFS: ");
+                    scanf("%d", &start);
+                    DFS_CSR(csr, start);
+                    break;
+                case 4:
+                    topologicalSortDFS_CSR(csr);
+                    break;
+                case 5:
+                    topologicalSortBFS_CSR(csr);
+                    break;
+                case 6:
+                    printf("Enter starting vertex for BFS Shortest Path: ");
+                    scanf("%d", &start);
+                    shortestPathBFS_CSR(csr, start);
+                    break;
+                case 7:
+                    printf("Enter starting vertex for Dijkstra's algorithm: ");
+                    scanf("%d", &start);
+                    shortestPathDijkstraCSR(csr, start);
+                    break;
+                case 8:
+                    if (directed)
+                        printf("Prim's MST is not applicable for directed graphs.\n");
+                    else
+                        primMST_CSR(csr);
+                    break;
+                case 9:
+                    printf("Enter starting vertex for BFS: ");
+                    scanf("%d", &start);
+                    if (!csrRev)
+                        csrRev = directed ? reverseCSR(csr) : csr;
+                    BFS_DirectionOptimizing(csr, csrRev, start);
+                    break;
+                case 10:
+                    printf("Enter starting vertex for BFS Shortest Path: ");
+                    scanf("%d", &start);
+                    shortestPathBFSParallel(csr, start);
+                    break;
+                case 11:
+                    printf("Enter starting vertex and heap arity (e.g. %d): ", DARY_HEAP_DEFAULT_ARITY);
+                    scanf("%d %d", &start, &arity);
+                    if (arity < 2)
+                        arity = DARY_HEAP_DEFAULT_ARITY;
+                    shortestPathDijkstraDary(csr, start, arity);
+                    break;
+                case 12:
+                    printf("Enter starting vertex and queue (0=Indexed MinHeap, 1=d-ary, 2=Radix, 3=Dial): ");
+                    scanf("%d %d", &start, &queueType);
+                    if (queueType < DIJKSTRA_INDEXED_HEAP || queueType > DIJKSTRA_DIAL)
+                    {
+                        printf("Invalid queue!\n");
+                        break;
+                    }
+                    shortestPathDijkstraQueue(csr, start, (DijkstraQueue)queueType);
+                    break;
+                case 13:
+                    printf("Enter starting vertex and delta (0 for automatic): ");
+                    scanf("%d %d", &start, &delta);
+                    shortestPathDeltaStepping(csr, start, delta);
+                    break;
+                case 14:
+                    printf("Enter source and target vertices: ");
+                    scanf("%d %d", &start, &target);
+                    if (!csrRev)
+                        csrRev = directed ? reverseCSR(csr) : csr;
+                    shortestPathBidirectional(csr, csrRev, start, target);
+                    break;
+                case 15:
+                    printf("Enter source and target vertices: ");
+                    scanf("%d %d", &start, &target);
+                    if (!csrRev)
+                        csrRev = directed ? reverseCSR(csr) : csr;
+                    if (!landmarks)
+                        landmarks = createLandmarks(csr, csrRev, ALT_DEFAULT_LANDMARKS);
+                    shortestPathAStar(csr, landmarks, start, target);
+                    break;
+                case 16:
+                    printf("Enter source and target vertices: ");
+                    scanf("%d %d", &start, &target);
+                    if (!hierarchy)
+                        hierarchy = buildContractionHierarchyCSR(csr);
+                    if (!hierarchy)
+                        printf("Contraction hierarchies require non-negative edge weights.\n");
+                    else
+                        shortestPathContractionHierarchy(hierarchy, start, target);
+                    break;
+                case 17:
+                    printf("Enter 0 to save or 1 to load, and a file name: ");
+                    scanf("%d %255s", &mode, fileName);
+                    if (mode == 1)
+                    {
+                        ContractionHierarchy *loaded = loadContractionHierarchy(fileName);
+                        if (!loaded || loaded->V != V)
+                        {
+                            printf("Could not load a hierarchy for %d vertices from %s.\n", V, fileName);
+                            freeContractionHierarchy(loaded);
+                            break;
+                        }
+                        freeContractionHierarchy(hierarchy);
+                        hierarchy = loaded;
+                        printf("Loaded hierarchy with %lld shortcuts.\n", hierarchy->shortcuts);
+                        break;
+                    }
+                    if (!hierarchy)
+                        hierarchy = buildContractionHierarchyCSR(csr);
+                    if (!hierarchy)
+                        printf("Contraction hierarchies require non-negative edge weights.\n");
+                    else if (!saveContractionHierarchy(hierarchy, fileName))
+                        printf("Could not write %s.\n", fileName);
+                    else
+                        printf("Saved hierarchy to %s.\n", fileName);
+                    break;
+                case 18:
+                    printf("Enter output file for the matrix (- to keep it in memory): ");
+                    scanf("%255s", fileName);
+                    allPairsShortestPathsJohnson(csr, strcmp(fileName, "-") == 0 ? NULL : fileName);
+                    break;
+                case 19:
+                    goto end_csr_menu;
+                default:
+                    printf("Invalid CSR choice! Please try again.\n");
+                }
+            }
+        end_csr_menu:;
+            break;
+        }
+        case 16:
+        {
+            // Benchmarks Menu (runs on generated data, not the loaded graph)
+            int bench_choice, n, nv, maxW, delta, queries;
+            while (1)
+            {
+                printf("\nBenchmarks Menu:\n");
+                printf("1. Kruskal Edge Sort (Bubble vs Radix)\n");
+                printf("2. MST (Kruskal vs Parallel Boruvka)\n");
+                printf("3. Parallel BFS Scaling\n");
+                printf("4. Dijkstra Priority Queues\n");
+                printf("5. Delta-Stepping Scaling\n");
+                printf("6. Point-to-Point Queries (Dijkstra vs Bidirectional vs A*)\n");
+                printf("7. Contraction Hierarchy Queries\n");
+                printf("8. Bellman-Ford Variants\n");
+                printf("9. Multi-Source Dijkstra (Batched)\n");
+                printf("10. Strongly Connected Components\n");
+                printf("11. Connected Components (Sequential vs Parallel DSU)\n");
+                printf("12. DSU Microbenchmarks\n");
+                printf("13. Edge List Loading\n");
+                printf("14. Graph Snapshot\n");
+                printf("15. Graph Build (Node Arena)\n");
+                printf("16. Dynamic Graph Updates\n");
+                printf("17. Incremental Shortest Paths\n");
+                printf("18. Return to Main Menu\n");
+                printf("Enter your benchmark choice: ");
+                scanf("%d", &bench_choice);
+
+                switch (bench_choice)
+                {
+                case 1:
+                    printf("Enter number of edges and max weight: ");
+                    scanf("%d %d", &n, &maxW);
+                    if (n < 0 || maxW < 1)
+                    {
+                        printf("Invalid parameters!\n");
+                        break;
+                    }
+                    benchmarkKruskalSort(n, maxW);
+                    break;
+                case 2:
+                    printf("Enter number of vertices, edges and max weight: ");
+                    scanf("%d %d %d", &nv, &n, &maxW);
+                    if (nv < 1 || n < 0 || maxW < 1)
+                    {
+                        printf("Invalid parameters!\n");
+                        break;
+                    }
+                    benchmarkMST(nv, n, maxW);
+                    break;
+                case 3:
+                    printf("Enter number of vertices and edges: ");
+                    scanf("%d %d", &nv, &n);
+                    if (nv < 1 || n < 0)
+                    {
+                        printf("Invalid parameters!\n");
+                        break;
+                    }
+                    benchmarkParallelBFS(nv, n);
+                    break;
+                case 4:
+                    printf("Enter number of vertices, edges and max weight: ");
+                    scanf("%d %d %d", &nv, &n, &maxW);
+                    if (nv < 1 || n < 0 || maxW < 1)
+                    {
+                        printf("Invalid parameters!\n");
+                        break;
+                    }
+                    benchmarkDijkstraHeaps(nv, n, maxW);
+                    break;
+                case 5:
+                    printf("Enter number of vertices, edges, max weight and delta (0 for automatic): ");
+                    scanf("%d %d %d %d", &nv, &n, &maxW, &delta);
+                    if (nv < 1 || n < 0 || maxW < 1)
+                    {
+                        printf("Invalid parameters!\n");
+                        break;
+                    }
+                    benchmarkDeltaStepping(nv, n, maxW, delta);
+                    break;
+                case 6:
+                    printf("Enter number of vertices, edges, max weight and queries: ");
+                    scanf("%d %d %d %d", &nv, &n, &maxW, &queries);
+                    if (nv < 1 || n < 0 || maxW < 1 || queries < 1)
+                    {
+                        printf("Invalid parameters!\n");
+                        break;
+                    }
+                    benchmarkPointToPoint(nv, n, maxW, queries);
+                    break;
+                case 7:
+                    printf("Enter grid side, max weight and queries: ");
+                    scanf("%d %d %d", &nv, &maxW, &queries);
+                    if (nv < 1 || maxW < 1 || queries < 1)
+                    {
+                        printf("Invalid parameters!\n");
+                        break;
+                    }
+                    benchmarkContractionHierarchy(nv, maxW, queries);
+                    break;
+                case 8:
+                    printf("Enter number of vertices, edges and max weight: ");
+                    scanf("%d %d %d", &nv, &n, &maxW);
+                    if (nv < 1 || n < 0 || maxW < 1)
+                    {
+                        printf("Invalid parameters!\n");
+                        break;
+                    }
+                    benchmarkBellmanFord(nv, n, maxW);
+                    break;
+                case 9:
+                    printf("Enter number of vertices, edges, max weight and sources: ");
+                    scanf("%d %d %d %d", &nv, &n, &maxW, &queries);
+                    if (nv < 1 || n < 0 || maxW < 1 || queries < 1)
+                    {
+                        printf("Invalid parameters!\n");
+                        break;
+                    }
+                    benchmarkMultiSource(nv, n, maxW, queries);
+                    break;
+                case 10:
+                    printf("Enter number of vertices and edges: ");
+                    scanf("%d %d", &nv, &n);
+                    if (nv < 1 || n < 0)
+                    {
+                        printf("Invalid parameters!\n");
+                        break;
+                    }
+                    benchmarkSCC(nv, n);
+                    break;
+                case 11:
+                    printf("Enter number of vertices and edges: ");
+                    scanf("%d %d", &nv, &n);
+                    if (nv < 1 || n < 0)
+                    {
+                        printf("Invalid parameters!\n");
+                        break;
+                    }
+                    benchmarkConnectedComponents(nv, n);
+                    break;
+                case 12:
+                    printf("Enter number of elements and unions: ");
+                    scanf("%d %d", &nv, &n);
+                    if (nv < 1 || n < 0)
+                    {
+                        printf("Invalid parameters!\n");
+                        break;
+                    }
+                    benchmarkDSU(nv, n);
+                    break;
+                case 13:
+                    printf("Enter number of vertices and edges: ");
+                    scanf("%d %d", &nv, &n);
+                    if (nv < 1 || n < 0)
+                    {
+                        printf("Invalid parameters!\n");
+                        break;
+                    }
+                    benchmarkEdgeListLoad(nv, n);
+                    break;
+                case 14:
+                    printf("Enter number of vertices and edges: ");
+                    scanf("%d %d", &nv, &n);
+                    if (nv < 1 || n < 0)
+                    {
+                        printf("Invalid parameters!\n");
+                        break;
+                    }
+                    benchmarkGraphSnapshot(nv, n);
+                    break;
+                case 15:
+                    printf("Enter number of vertices and edges: ");
+                    scanf("%d %d", &nv, &n);
+                    if (nv < 1 || n < 0)
+                    {
+                        printf("Invalid parameters!\n");
+                        break;
+                    }
+                    benchmarkGraphBuild(nv, n);
+                    break;
+                case 16:
+                    printf("Enter number of vertices, edges and batch size: ");
+                    scanf("%d %d %d", &nv, &n, &queries);
+                    if (nv < 1 || n < 0 || queries < 1)
+                    {
+                        printf("Invalid parameters!\n");
+                        break;
+                    }
+                    benchmarkDynamicGraph(nv, n, queries);
+                    break;
+                case 17:
+                    printf("Enter number of vertices, edges and weight changes per round: ");
+                    scanf("%d %d %d", &nv, &n, &queries);
+                    if (nv < 1 || n < 0 || queries < 0)
+                    {
+                        printf("Invalid parameters!\n");
+                        break;
+                    }
+                    benchmarkIncrementalSSSP(nv, n, queries);
+                    break;
+                case 18:
+                    goto end_bench_menu;
+                default:
+                    printf("Invalid benchmark choice! Please try again.\n");
+                }
+            }
+        end_bench_menu:;
+            break;
+        }
+        case 17:
+            boruvkaMST(graph, edges, E);
+            break;
+        case 18:
+            printf("Enter starting vertex for SPFA: ");
+            scanf("%d", &start);
+            shortestPathSPFA(V, edges, E, start);
+            break;
+        case 19:
+            printf("Enter starting vertex for Bellman-Ford: ");
+            scanf("%d", &start);
+            shortestPathBellmanFordParallel(V, edges, E, start);
+            break;
+        case 20:
+            stronglyConnectedComponents(graph);
+            break;
+        case 21:
+            connectedComponents(V, edges, E);
+            break;
+        case 22:
+        {
+            char fileName[256];
+            printf("Enter file name: ");
+            scanf("%255s", fileName);
+            if (saveEdgeListBinary(fileName, V, edges, E, directed))
+                printf("Saved %d edges to %s\n", E, fileName);
+            else
+                printf("Cannot write %s\n", fileName);
+            break;
+        }
+        case 23:
+        {
+            char fileName[256];
+            printf("Enter file name: ");
+            scanf("%255s", fileName);
+            if (saveGraphSnapshot(fileName, csr, edges, E, directed))
+                printf("Saved snapshot to %s\n", fileName);
+            else
+                printf("Cannot write %s\n", fileName);
+            break;
+        }
+        case 24:
+        {
+            // Dynamic Graph Menu: a mutable copy, updates do not reach the other menus
+            int dyn_choice, count;
+            if (!dynamic)
+            {
+                dynamic = createDynamicGraph(V, directed);
+                dynamicGraphInsertEdges(dynamic, edges, E, getThreadCount());
+            }
+            while (1)
+            {
+                printf("\nDynamic Graph Menu:\n");
+                printf("1. Insert Edges (Batch)\n");
+                printf("2. Delete Edges (Batch)\n");
+                printf("3. Print Dynamic Graph\n");
+                printf("4. Shortest Path BFS (Dynamic)\n");
+                printf("5. Shortest Path Dijkstra (Dynamic)\n");
+                printf("6. Change Edge Weights (Batch, Incremental Dijkstra)\n");
+                printf("7. Return to Main Menu\n");
+                printf("Enter your dynamic graph choice: ");
+                scanf("%d", &dyn_choice);
+
+                switch (dyn_choice)
+                {
+                case 1:
+                case 2:
+                {
+                    printf("Enter number of edges: ");
+                    scanf("%d", &count);
+                    if (count < 0)
+                    {
+                        printf("Invalid count!\n");
+                        break;
+                    }
+                    Edge *batch = malloc((count > 0 ? count : 1) * sizeof(Edge));
+                    printf("Enter edges in format (src dest weight):\n");
+                    for (int i = 0; i < count; i++)
+                        scanf("%d %d %d", &batch[i].src, &batch[i].dest, &batch[i].weight);
+                    long long changed = dyn_choice == 1 ? dynamicGraphInsertEdges(dynamic, batch, count, getThreadCount())
+                                                        : dynamicGraphDeleteEdges(dynamic, batch, count, getThreadCount());
+                    if (changed < 0)
+                        printf("Invalid vertex in batch, nothing changed!\n");
+                    else
+                        printf("%s %lld arcs.\n", dyn_choice == 1 ? "Inserted" : "Deleted", changed);
+                    free(batch);
+                    break;
+                }
+                case 3:
+                    printDynamicGraph(dynamic);
+                    break;
+                case 4:
+                    printf("Enter starting vertex for BFS Shortest Path: ");
+                    scanf("%d", &start);
+                    shortestPathBFSDynamic(dynamic, start);
+                    break;
+                case 5:
+                    printf("Enter starting vertex for Dijkstra's algorithm: ");
+                    scanf("%d", &start);
+                    shortestPathDijkstraDynamic(dynamic, start);
+                    break;
+                case 6:
+                {
+                    printf("Enter starting vertex for Dijkstra's algorithm: ");
+                    scanf("%d", &start);
+                    printf("Enter number of weight changes: ");
+                    scanf("%d", &count);
+                    if (count < 0)
+                    {
+                        printf("Invalid count!\n");
+                        break;
+                    }
+                    WeightChange *changes = malloc((count > 0 ? count : 1) * sizeof(WeightChange));
+                    printf("Enter changes in format (src dest oldWeight newWeight):\n");
+                    for (int i = 0; i < count; i++)
+                        scanf("%d %d %d %d", &changes[i].src, &changes[i].dest, &changes[i].oldWeight,
+                              &changes[i].newWeight);
+                    shortestPathDijkstraIncremental(dynamic, start, changes, count);
+                    free(changes);
+                    break;
+                }
+                case 7:
+                    goto end_dynamic_menu;
+                default:
+                    printf("Invalid dynamic graph choice! Please try again.\n");
+                }
+            }
+        end_dynamic_menu:;
+            break;
+        }
+        case 25:
             printf("Exiting...\n");
             // Free allocated memory before exiting
             // For simplicity, not freeing all memory here